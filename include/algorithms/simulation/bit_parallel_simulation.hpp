@@ -0,0 +1,207 @@
+#pragma once
+
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+#include "core/properties.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Word type of a bit-sliced circuit line
+    *
+    * In bit-sliced simulation every circuit line is represented by one word,
+    * where bit \em k of the word holds the value of the line for pattern \em k.
+    */
+    using PatternWord = std::uint64_t;
+
+    /**
+    * @brief Number of patterns that are simulated simultaneously in one word
+    */
+    constexpr std::size_t PATTERNS_PER_WORD = 64U;
+
+    /**
+    * @brief Bit-sliced simulation of a single gate \p g
+    *
+    * This is the bit-parallel counterpart of \ref syrec::coreGateSimulation "coreGateSimulation".
+    * A Toffoli gate becomes <tt>t ^= c1 & c2 & ...</tt> and a Fredkin gate a masked swap
+    * of its two targets, applied to all patterns held in the words at once.
+    *
+    * @param g     The gate to be simulated
+    * @param lines One word per circuit line. Bit \em k of each word belongs to pattern \em k.
+    */
+    void bitParallelGateSimulation(const Gate& g, std::vector<PatternWord>& lines);
+
+    /**
+    * @brief Transposes a block of patterns into bit-sliced words
+    *
+    * Line \em l of pattern \em k is stored in bit <tt>k % 64</tt> of word <tt>l * nWords + k / 64</tt>,
+    * all other bits of \p lines are cleared. With \p nWords words per line, a block holds up to
+    * <tt>nWords * 64</tt> patterns.
+    *
+    * @param lines    Bit-sliced words, \p nWords per line
+    * @param patterns First pattern of the block
+    * @param count    Number of patterns in the block
+    * @param nWords   Number of words per line
+    *
+    * @throws std::invalid_argument If a pattern does not have as many bits as \p lines has lines
+    */
+    void loadPatternBlock(std::vector<PatternWord>& lines, const boost::dynamic_bitset<>* patterns, std::size_t count, std::size_t nWords = 1U);
+
+    /**
+    * @brief Transposes bit-sliced words back into a block of patterns
+    *
+    * Inverse of loadPatternBlock(): pattern \em k is overwritten with one bit per line of \p lines.
+    *
+    * @param patterns First pattern of the block
+    * @param lines    Bit-sliced words, \p nWords per line
+    * @param count    Number of patterns in the block
+    * @param nWords   Number of words per line
+    */
+    void storePatternBlock(boost::dynamic_bitset<>* patterns, const std::vector<PatternWord>& lines, std::size_t count, std::size_t nWords = 1U);
+
+    /**
+    * @brief Bit-parallel simulation of a batch of patterns
+    *
+    * Simulates all patterns in \p inputs through the circuit \p circ. The patterns are
+    * transposed into bit-sliced words such that #PATTERNS_PER_WORD patterns share one
+    * pass over the gates. On CPUs with AVX2 or AVX-512, blocks of 256 or 512 patterns are
+    * simulated by the vectorized kernels of simdSimulation. The result agrees bit-for-bit with calling
+    * \ref syrec::simpleSimulation "simpleSimulation" on each pattern separately.
+    *
+    * @param outputs Output patterns. Resized to the number of input patterns.
+    * @param circ Circuit to be simulated.
+    * @param inputs Input patterns. Each pattern must have as many bits as the circuit has lines.
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    *
+    * @throws std::invalid_argument If an input pattern does not have as many bits as the circuit has lines
+    */
+    void bitParallelSimulation(std::vector<boost::dynamic_bitset<>>& outputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                               const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Bit-parallel simulation of a batch of patterns on a compiled circuit
+    *
+    * Same as the overload taking a \ref syrec::Circuit "Circuit", but runs on an already
+    * compiled circuit. Use this overload when the same circuit is simulated many times.
+    */
+    void bitParallelSimulation(std::vector<boost::dynamic_bitset<>>& outputs, const CompiledCircuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                               const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Bit-sliced simulation of one block of patterns on a compiled circuit
+    *
+    * Applies all gates of \p circ to the bit-sliced words in \p lines in place.
+    *
+    * @param lines One word per circuit line. Bit \em k of each word belongs to pattern \em k.
+    * @param circ  Compiled circuit to be simulated.
+    */
+    void bitParallelSimulation(std::vector<PatternWord>& lines, const CompiledCircuit& circ);
+
+    /**
+    * @brief Bit-parallel simulation of packed patterns
+    *
+    * Pattern \em k occupies the \p stride bytes starting at <tt>inputs + k * stride</tt>, where the
+    * value of line \em l is bit <tt>l % 8</tt> of byte <tt>l / 8</tt>. The output patterns are written
+    * in the same layout to \p outputs, with all bits beyond the last line cleared. This allows to simulate
+    * rows of externally owned buffers, e.g., NumPy arrays, without converting them into bitsets.
+    * \p outputs may be equal to \p inputs.
+    *
+    * @param outputs   Buffer of <tt>nPatterns * stride</tt> bytes receiving the output patterns
+    * @param inputs    Buffer of <tt>nPatterns * stride</tt> bytes holding the input patterns
+    * @param nPatterns Number of patterns
+    * @param stride    Number of bytes per pattern, at least <tt>ceil(lines / 8)</tt>
+    * @param circ      Compiled circuit to be simulated
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    *
+    * @throws std::invalid_argument If \p stride is too small to hold all lines
+    */
+    void bitParallelSimulation(std::uint8_t* outputs, const std::uint8_t* inputs, std::size_t nPatterns, std::size_t stride, const CompiledCircuit& circ,
+                               const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Bit-parallel simulation of packed patterns of 64-bit words
+    *
+    * Same as the overload on bytes, but pattern \em k occupies the \p stride words starting
+    * at <tt>inputs + k * stride</tt> and the value of line \em l is bit <tt>l % 64</tt> of word <tt>l / 64</tt>.
+    */
+    void bitParallelSimulation(std::uint64_t* outputs, const std::uint64_t* inputs, std::size_t nPatterns, std::size_t stride, const CompiledCircuit& circ,
+                               const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Bit-sliced simulation of the gates <tt>[first, last)</tt> of a compiled circuit
+    *
+    * @param lines One word per circuit line. Bit \em k of each word belongs to pattern \em k.
+    * @param circ  Compiled circuit to be simulated.
+    * @param first Index of the first gate to be simulated
+    * @param last  Index past the last gate to be simulated
+    */
+    void bitParallelSimulation(std::vector<PatternWord>& lines, const CompiledCircuit& circ, std::size_t first, std::size_t last);
+
+    /**
+    * @brief Bit-sliced simulation of the gates <tt>[first, last)</tt> with a gate observer
+    *
+    * After every gate \em g, <tt>observer(g, active, toggled)</tt> is called, where \em active holds the
+    * patterns for which all controls of the gate are set and \em toggled the patterns for which the gate
+    * changed its target lines. The overloads without observer pass an empty one, which the compiler
+    * removes entirely, so the instrumentation does not cost anything when it is not used.
+    *
+    * @param lines    One word per circuit line. Bit \em k of each word belongs to pattern \em k.
+    * @param circ     Compiled circuit to be simulated.
+    * @param first    Index of the first gate to be simulated
+    * @param last     Index past the last gate to be simulated
+    * @param observer Callable as <tt>observer(std::size_t, PatternWord, PatternWord)</tt>
+    */
+    template<typename Observer>
+    void bitParallelSimulation(std::vector<PatternWord>& lines, const CompiledCircuit& circ, const std::size_t first, const std::size_t last, Observer&& observer) {
+        for (std::size_t g = first; g < last; ++g) {
+            // patterns for which all controls are set
+            PatternWord active = ~PatternWord{0U};
+            for (const auto* c = circ.controlsBegin(g); c != circ.controlsEnd(g); ++c) {
+                active &= lines[*c];
+            }
+
+            if (circ.type(g) == Gate::Types::Toffoli) {
+                lines[circ.target1(g)] ^= active;
+                observer(g, active, active);
+            } else if (circ.type(g) == Gate::Types::Fredkin) {
+                // only swap where both targets differ
+                const PatternWord diff = (lines[circ.target1(g)] ^ lines[circ.target2(g)]) & active;
+                lines[circ.target1(g)] ^= diff;
+                lines[circ.target2(g)] ^= diff;
+                observer(g, active, diff);
+            } else {
+                std::cerr << "Unknown gate: Simulation error\n";
+            }
+        }
+    }
+
+} // namespace syrec
@@ -1,10 +1,40 @@
 #pragma once
 
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
 #include "core/truthTable/truth_table.hpp"
 #include "ir/QuantumComputation.hpp"
 
 namespace syrec {
 
-    auto buildTruthTable(const qc::QuantumComputation& qc, TruthTable& tt) -> void;
+    /**
+    * @brief Builds the truth table of the circuit \p qc
+    *
+    * Constant (ancillary) inputs are fixed to zero, so only the primary inputs are enumerated, and
+    * garbage outputs are reported as zero. Circuits consisting of single-target X/MCX and SWAP operations
+    * only (without qubit permutations) are evaluated classically on bit-sliced words, 64 inputs at a time,
+    * with chunks of the input space distributed over \p nThreads threads by work stealing. All other
+    * circuits are simulated input by input using decision diagrams.
+    *
+    * @param qc       Circuit whose truth table is built
+    * @param tt       Truth table to be filled
+    * @param nThreads Number of threads for the classical evaluation. 0 uses all available cores.
+    */
+    auto buildTruthTable(const qc::QuantumComputation& qc, TruthTable& tt, unsigned nThreads = 0U) -> void;
+
+    /**
+    * @brief Builds the truth table of the reversible circuit \p circ
+    *
+    * The truth table is filled by an exhaustive simulation of all primary inputs, see
+    * \ref syrec::exhaustiveSimulation "exhaustiveSimulation". Constant lines are set to their
+    * constant value and garbage outputs are reported as zero, like for the overload taking a
+    * quantum computation. Bit \em l of a pattern corresponds to line \em l, i.e., the first character
+    * of a cube corresponds to the last line.
+    *
+    * @param circ     Circuit whose truth table is built. Must have less than 64 primary inputs.
+    * @param tt       Truth table to be filled
+    * @param settings Settings of the exhaustive simulation
+    */
+    auto buildTruthTable(const Circuit& circ, TruthTable& tt, const Properties::ptr& settings = Properties::ptr()) -> void;
 
 } // namespace syrec
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Flattened, simulation-ready representation of a circuit
+    *
+    * A compiled circuit is built once from a \ref syrec::Circuit "Circuit" and stores
+    * its gates in a contiguous structure-of-arrays layout: gate types, target indices,
+    * a flat list of control lines and precomputed control masks. The simulation
+    * functions run on this representation so that repeated simulations of the same
+    * circuit do not have to rebuild any per-gate data.
+    *
+    * The compiled circuit is a snapshot. Gates added to the source circuit afterwards
+    * are not reflected. Instances of sub-circuits are compiled without expanding them
+    * in the source circuit.
+    */
+    class CompiledCircuit {
+    public:
+        /**
+        * @brief Type of a line index
+        */
+        using line = unsigned;
+
+        /**
+        * @brief Type of a word of a control mask
+        */
+        using mask_word = std::uint64_t;
+
+        /**
+        * @brief Number of lines covered by one word of a control mask
+        */
+        static constexpr std::size_t MASK_WORD_BITS = 64U;
+
+        CompiledCircuit() = default;
+
+        /**
+        * @brief Compiles the circuit \p circ
+        *
+        * @param circ Circuit to be compiled
+        */
+        explicit CompiledCircuit(const Circuit& circ);
+
+        /**
+        * @brief Returns the inverse of this circuit
+        *
+        * Toffoli and Fredkin gates are self-inverse, hence the inverse consists of
+        * the same gates in reverse order. Simulating the inverse maps output patterns
+        * back to the input patterns that produce them, using the same simulation
+        * functions as in forward direction.
+        */
+        [[nodiscard]] CompiledCircuit inverse() const;
+
+        /**
+        * @brief Returns the number of gates
+        */
+        [[nodiscard]] std::size_t numGates() const {
+            return types.size();
+        }
+
+        /**
+        * @brief Returns the number of lines
+        */
+        [[nodiscard]] unsigned getLines() const {
+            return lines;
+        }
+
+        /**
+        * @brief Returns the number of words of each control mask
+        */
+        [[nodiscard]] std::size_t maskWords() const {
+            return nMaskWords;
+        }
+
+        /**
+        * @brief Returns the type of gate \p g
+        */
+        [[nodiscard]] Gate::Types type(std::size_t g) const {
+            return types[g];
+        }
+
+        /**
+        * @brief Returns the (first) target of gate \p g
+        */
+        [[nodiscard]] line target1(std::size_t g) const {
+            return targets1[g];
+        }
+
+        /**
+        * @brief Returns the second target of gate \p g
+        *
+        * Only meaningful for Fredkin gates.
+        */
+        [[nodiscard]] line target2(std::size_t g) const {
+            return targets2[g];
+        }
+
+        /**
+        * @brief Returns the number of controls of gate \p g
+        */
+        [[nodiscard]] std::size_t numControls(std::size_t g) const {
+            return controlOffsets[g + 1U] - controlOffsets[g];
+        }
+
+        /**
+        * @brief Pointer to the first control line of gate \p g
+        *
+        * The control lines of a gate are stored in ascending order.
+        */
+        [[nodiscard]] const line* controlsBegin(std::size_t g) const {
+            return controlLines.data() + controlOffsets[g];
+        }
+
+        /**
+        * @brief Pointer past the last control line of gate \p g
+        */
+        [[nodiscard]] const line* controlsEnd(std::size_t g) const {
+            return controlLines.data() + controlOffsets[g + 1U];
+        }
+
+        /**
+        * @brief Control mask of gate \p g
+        *
+        * The mask consists of \ref maskWords words, where bit \em i of word \em w
+        * is set if line <tt>w * MASK_WORD_BITS + i</tt> is a control line.
+        */
+        [[nodiscard]] const mask_word* controlMask(std::size_t g) const {
+            return controlMasks.data() + (g * nMaskWords);
+        }
+
+    private:
+        unsigned    lines{};
+        std::size_t nMaskWords{};
+
+        std::vector<Gate::Types> types;
+        std::vector<line>        targets1;
+        std::vector<line>        targets2;
+        std::vector<std::size_t> controlOffsets;
+        std::vector<line>        controlLines;
+        std::vector<mask_word>   controlMasks;
+    };
+
+} // namespace syrec
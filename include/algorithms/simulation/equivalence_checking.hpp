@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+
+namespace syrec {
+
+    /**
+    * @brief Outcome of an equivalence check
+    */
+    enum class EquivalenceResult {
+        /** All assignments of the primary inputs have been simulated without a mismatch */
+        Equivalent,
+        /** A counterexample has been found */
+        NotEquivalent,
+        /** No mismatch has been found by random simulation, but the input space was too large to be proven exhaustively */
+        ProbablyEquivalent,
+        /** The primary inputs or outputs of the circuits cannot be aligned by name */
+        IncompatibleInterfaces
+    };
+
+    /**
+    * @brief Simulation-based equivalence checking of two circuits
+    *
+    * The primary inputs (non-constant lines) of both circuits are aligned by their input names, and the
+    * primary outputs (non-garbage lines) by their output names, such that circuits with different numbers
+    * of lines, e.g., results of line-aware and cost-aware synthesis of the same program, can be compared.
+    * Garbage outputs are ignored and constant lines are fixed to their values.
+    *
+    * First, <em>random_patterns</em> random input assignments are simulated bit-parallel to refute
+    * equivalence quickly. If no mismatch is found and the circuits have at most <em>exhaustive_inputs</em>
+    * primary inputs, all input assignments are simulated to prove equivalence. Both phases are split into
+    * blocks of 64 patterns and distributed over a work-stealing thread pool, which stops as soon as a
+    * counterexample is found.
+    *
+    * @param counterexample Set to an input pattern of \p circ1 on which the circuits differ if the result is
+    *                       EquivalenceResult::NotEquivalent. The corresponding input pattern of \p circ2 assigns
+    *                       the same values to the primary inputs of the same names.
+    * @param circ1 First circuit
+    * @param circ2 Second circuit
+    * @param settings <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Setting</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Default Value</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">random_patterns</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">65536</td>
+    *     <td class="indexvalue">Number of random input assignments simulated before the exhaustive check.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">seed</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Seed of the random input assignments.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">exhaustive_inputs</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">24</td>
+    *     <td class="indexvalue">Largest number of primary inputs for which equivalence is proven exhaustively.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">num_threads</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Number of threads. 0 uses all available cores.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">chunk_size</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">16</td>
+    *     <td class="indexvalue">Number of blocks of 64 patterns that are handed to a thread at once.</td>
+    *   </tr>
+    * </table>
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    * @return Outcome of the check
+    */
+    EquivalenceResult checkEquivalence(boost::dynamic_bitset<>& counterexample, const Circuit& circ1, const Circuit& circ2,
+                                       const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
+} // namespace syrec
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Receiver of the results of an exhaustive simulation
+    *
+    * The sink is called once per block of up to #PATTERNS_PER_WORD consecutive inputs with
+    * the index of the first input of the block, the number of valid patterns in the block and
+    * the bit-sliced output words (one word per line, bit \em k belongs to input <tt>firstInput + k</tt>).
+    *
+    * \b Important: The sink is called concurrently from several threads and has to be thread-safe.
+    */
+    using ExhaustiveSimulationSink = std::function<void(std::uint64_t firstInput, std::size_t count, const std::vector<PatternWord>& outputs)>;
+
+    /**
+    * @brief Returns the number of primary inputs of \p circ, i.e., the number of non-constant lines
+    */
+    [[nodiscard]] std::size_t numPrimaryInputs(const Circuit& circ);
+
+    /**
+    * @brief Returns the input pattern with index \p index of an exhaustive simulation
+    *
+    * Bit \em p of \p index is assigned to the \em p-th non-constant line (in ascending line order),
+    * constant lines are set to their constant value.
+    *
+    * @param circ  Circuit whose input space is enumerated
+    * @param index Index of the input pattern
+    * @return Input pattern with as many bits as the circuit has lines
+    */
+    [[nodiscard]] boost::dynamic_bitset<> exhaustiveInputPattern(const Circuit& circ, std::uint64_t index);
+
+    /**
+    * @brief Exhaustive simulation of a circuit over all assignments of its primary inputs
+    *
+    * The input space of the non-constant lines is enumerated as described in exhaustiveInputPattern,
+    * split into chunks of bit-sliced blocks and processed by a work-stealing thread pool, each thread
+    * using its own simulation state. The results of every block are streamed to \p sink.
+    *
+    * @param circ Circuit to be simulated. Must have less than 64 primary inputs.
+    * @param sink Receiver of the simulation results
+    * @param settings <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Setting</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Default Value</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">num_threads</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Number of threads. 0 uses all available cores.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">chunk_size</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">16</td>
+    *     <td class="indexvalue">Number of blocks of #PATTERNS_PER_WORD inputs that are handed to a thread at once.</td>
+    *   </tr>
+    * </table>
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    *
+    * @throws std::invalid_argument If \p circ has 64 or more primary inputs
+    */
+    void exhaustiveSimulation(const Circuit& circ, const ExhaustiveSimulationSink& sink,
+                              const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Exhaustive simulation of a circuit into a packed output array
+    *
+    * Same as exhaustiveSimulation(const Circuit&, const ExhaustiveSimulationSink&, const Properties::ptr&, const Properties::ptr&),
+    * but stores all output patterns in \p outputs. Every pattern occupies <tt>w = ceil(lines / 64)</tt>
+    * consecutive words, i.e., bit \em l of the output for input \em i is bit <tt>l % 64</tt> of
+    * word <tt>i * w + l / 64</tt>.
+    *
+    * @param outputs Packed output patterns, resized to <tt>2^n * w</tt> words for \em n primary inputs
+    * @param circ Circuit to be simulated. Must have less than 64 primary inputs.
+    * @param settings Same as for the overload taking a sink.
+    * @param statistics Same as for the overload taking a sink.
+    *
+    * @throws std::invalid_argument If \p circ has 64 or more primary inputs
+    * @throws std::length_error If the packed outputs exceed the maximum size of \p outputs
+    */
+    void exhaustiveSimulation(std::vector<std::uint64_t>& outputs, const Circuit& circ,
+                              const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
+} // namespace syrec
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+#include "core/properties.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief A single fault of a reversible circuit
+    */
+    struct Fault {
+        /**
+        * @brief Fault model
+        */
+        enum class Types {
+            /** The gate #gate is not applied */
+            MissingGate,
+            /** The gate #gate is applied twice */
+            RepeatedGate,
+            /** The line #line holds the value 0 in front of the gate #gate */
+            StuckAt0,
+            /** The line #line holds the value 1 in front of the gate #gate */
+            StuckAt1
+        };
+
+        /**
+        * @brief Fault model
+        */
+        Types type = Types::MissingGate;
+
+        /**
+        * @brief Index of the faulty gate
+        *
+        * For stuck-at faults, the position of the fault in front of this gate.
+        * A position equal to the number of gates denotes the circuit outputs.
+        */
+        std::size_t gate = 0U;
+
+        /**
+        * @brief Faulty line of a stuck-at fault
+        */
+        Gate::line line = 0U;
+    };
+
+    /**
+    * @brief Returns all single faults of \p circ
+    *
+    * One missing-gate and one repeated-gate fault per gate, as well as a stuck-at-0 and a stuck-at-1
+    * fault per line in front of every gate and at the outputs.
+    *
+    * Since Toffoli and Fredkin gates are self-inverse, a repeated gate has the same effect as a
+    * missing gate, and both are detected by the same tests.
+    */
+    [[nodiscard]] std::vector<Fault> enumerateFaults(const Circuit& circ);
+
+    /**
+    * @brief Parallel-pattern fault simulation
+    *
+    * Simulates the test patterns in \p tests on the fault-free and all faulty circuits. The fault-free
+    * state in front of every checkpoint_interval-th gate is recorded once per block of 64 bit-sliced patterns,
+    * such that every faulty circuit only has to be simulated from the checkpoint in front of its fault location onwards. Faults are distributed over a
+    * work-stealing thread pool, and a detected fault is not simulated for the remaining patterns.
+    *
+    * A fault is detected if at least one test pattern yields an output pattern that differs from the fault-free one.
+    *
+    * @param detected Resized to the number of faults, entry \em i is true if <tt>faults[i]</tt> is detected
+    * @param circ Circuit under test
+    * @param faults Faults to be simulated, e.g., as returned by enumerateFaults
+    * @param tests Test patterns. Each pattern must have as many bits as the circuit has lines.
+    * @param settings <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Setting</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Default Value</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">num_threads</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Number of threads. 0 uses all available cores.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">chunk_size</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">64</td>
+    *     <td class="indexvalue">Number of faults that are handed to a thread at once.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">checkpoint_interval</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Number of gates between two recorded fault-free states. 0 records at most about 1024 states.</td>
+    *   </tr>
+    * </table>
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">coverage</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Fraction of detected faults.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    * @return Fraction of detected faults, 1 if \p faults is empty
+    *
+    * @throws std::invalid_argument If a test pattern does not have as many bits as the circuit has lines
+    */
+    double faultSimulation(std::vector<bool>& detected, const Circuit& circ, const std::vector<Fault>& faults, const std::vector<boost::dynamic_bitset<>>& tests,
+                           const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Generates a compact test set for the faults in \p faults
+    *
+    * Candidate patterns are drawn from the input space of the non-constant lines, with constant lines fixed
+    * to their values. For circuits with at most <em>exhaustive_inputs</em> primary inputs, all assignments are
+    * candidates, such that the resulting test set is complete, i.e., it detects every detectable fault. Otherwise,
+    * <em>random_patterns</em> random assignments are used.
+    *
+    * The candidates are fault simulated in blocks of 64 patterns. Within each block, the pattern detecting the
+    * most yet undetected faults is added to the test set until no pattern of the block detects further faults.
+    *
+    * @param tests The generated test patterns
+    * @param circ Circuit under test
+    * @param faults Faults to be detected, e.g., as returned by enumerateFaults
+    * @param settings <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Setting</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Default Value</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">exhaustive_inputs</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">20</td>
+    *     <td class="indexvalue">Largest number of primary inputs for which all input assignments are candidates.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">random_patterns</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">65536</td>
+    *     <td class="indexvalue">Number of random candidates for larger circuits.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">seed</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Seed of the random candidates.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">num_threads</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Number of threads. 0 uses all available cores.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">chunk_size</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">64</td>
+    *     <td class="indexvalue">Number of faults that are handed to a thread at once.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">checkpoint_interval</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Number of gates between two recorded fault-free states. 0 records at most about 1024 states.</td>
+    *   </tr>
+    * </table>
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">coverage</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Fraction of faults detected by the generated test set.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    * @return Fraction of faults detected by the generated test set, 1 if \p faults is empty
+    */
+    double generateTestSet(std::vector<boost::dynamic_bitset<>>& tests, const Circuit& circ, const std::vector<Fault>& faults,
+                           const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
+} // namespace syrec
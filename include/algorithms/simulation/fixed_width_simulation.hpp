@@ -0,0 +1,109 @@
+#pragma once
+
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/gate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace syrec {
+
+    /**
+    * @brief Largest number of mask words for which a fixed-width kernel is instantiated
+    *
+    * Circuits with up to <tt>MAX_FIXED_WIDTH_WORDS * 64</tt> lines are simulated on a
+    * stack-allocated state, wider circuits fall back to \p boost::dynamic_bitset.
+    */
+    constexpr std::size_t MAX_FIXED_WIDTH_WORDS = 4U;
+
+    /**
+    * @brief Simulation state of a circuit with at most <tt>N * 64</tt> lines
+    *
+    * Bit \em i of word \em w holds the value of line <tt>w * 64 + i</tt>.
+    */
+    template<std::size_t N>
+    using FixedWidthState = std::array<CompiledCircuit::mask_word, N>;
+
+    /**
+    * @brief Simulates the gates <tt>[first, last)</tt> of \p circ on a fixed-width state
+    *
+    * The number of words \p N has to be equal to CompiledCircuit::maskWords() such that
+    * the control masks of the compiled circuit can be compared word by word.
+    *
+    * @param state Simulation state, modified in place
+    * @param circ  Compiled circuit to be simulated
+    * @param first Index of the first gate to be simulated
+    * @param last  Index past the last gate to be simulated
+    */
+    template<std::size_t N>
+    void fixedWidthSimulation(FixedWidthState<N>& state, const CompiledCircuit& circ, std::size_t first, std::size_t last) {
+        constexpr std::size_t bits = CompiledCircuit::MASK_WORD_BITS;
+        using word                 = CompiledCircuit::mask_word;
+
+        for (std::size_t g = first; g < last; ++g) {
+            const word* mask   = circ.controlMask(g);
+            bool        active = true;
+            for (std::size_t w = 0U; w < N; ++w) {
+                active = active && ((state[w] & mask[w]) == mask[w]);
+            }
+            if (!active) {
+                continue;
+            }
+
+            const auto t1 = circ.target1(g);
+            if (circ.type(g) == Gate::Types::Toffoli) {
+                state[t1 / bits] ^= word{1U} << (t1 % bits);
+            } else if (circ.type(g) == Gate::Types::Fredkin) {
+                const auto t2 = circ.target2(g);
+                // only swap when different
+                if ((((state[t1 / bits] >> (t1 % bits)) ^ (state[t2 / bits] >> (t2 % bits))) & 1U) != 0U) {
+                    state[t1 / bits] ^= word{1U} << (t1 % bits);
+                    state[t2 / bits] ^= word{1U} << (t2 % bits);
+                }
+            } else {
+                std::cerr << "Unknown gate: Simulation error\n";
+            }
+        }
+    }
+
+    /**
+    * @brief Simulates all gates of \p circ on a fixed-width state
+    */
+    template<std::size_t N>
+    void fixedWidthSimulation(FixedWidthState<N>& state, const CompiledCircuit& circ) {
+        fixedWidthSimulation<N>(state, circ, 0U, circ.numGates());
+    }
+
+    /**
+    * @brief Loads the pattern \p pattern into a fixed-width state
+    */
+    template<std::size_t N>
+    FixedWidthState<N> toFixedWidthState(const boost::dynamic_bitset<>& pattern) {
+        constexpr std::size_t bits = CompiledCircuit::MASK_WORD_BITS;
+
+        FixedWidthState<N> state{};
+        for (auto l = pattern.find_first(); l < N * bits; l = pattern.find_next(l)) {
+            state[l / bits] |= CompiledCircuit::mask_word{1U} << (l % bits);
+        }
+        return state;
+    }
+
+    /**
+    * @brief Stores the fixed-width state \p state into \p pattern
+    *
+    * The size of \p pattern is kept, bits of \p pattern beyond the N * 64 bits of the state are left unchanged.
+    */
+    template<std::size_t N>
+    void fromFixedWidthState(boost::dynamic_bitset<>& pattern, const FixedWidthState<N>& state) {
+        constexpr std::size_t bits = CompiledCircuit::MASK_WORD_BITS;
+
+        for (std::size_t l = 0U; l < std::min(pattern.size(), N * bits); ++l) {
+            pattern.set(l, ((state[l / bits] >> (l % bits)) & 1U) != 0U);
+        }
+    }
+
+} // namespace syrec
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Inverse simulation of a circuit
+    *
+    * Simulates the inverse of \p circ, starting from the output pattern \p output, on the
+    * kernels of \ref syrec::simpleSimulation "simpleSimulation" and writes the input pattern
+    * that produces \p output to \p input.
+    *
+    * To simulate the same circuit backwards many times, simulate CompiledCircuit::inverse()
+    * with the forward simulation functions instead.
+    *
+    * @param input Input pattern. The index of the pattern corresponds to the line index.
+    * @param circ Circuit to be simulated backwards.
+    * @param output Output pattern. The bit-width has to be initialized properly to the number of lines.
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    */
+    void inverseSimulation(boost::dynamic_bitset<>& input, const Circuit& circ, const boost::dynamic_bitset<>& output,
+                           const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Bit-parallel inverse simulation of a batch of output patterns
+    *
+    * Counterpart of \ref syrec::bitParallelSimulation "bitParallelSimulation" that maps every
+    * pattern in \p outputs to its input pattern, by simulating the inverse circuit on the
+    * bit-sliced and vectorized kernels.
+    *
+    * @param inputs Input patterns. Resized to the number of output patterns.
+    * @param circ Circuit to be simulated backwards.
+    * @param outputs Output patterns. Each pattern must have as many bits as the circuit has lines.
+    * @param statistics Same as for inverseSimulation.
+    */
+    void inverseBitParallelSimulation(std::vector<boost::dynamic_bitset<>>& inputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& outputs,
+                                      const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Checks whether \p input is a feasible input pattern of \p circ
+    *
+    * An input pattern is feasible if all constant lines hold their constant value.
+    */
+    [[nodiscard]] bool isFeasiblePreimage(const Circuit& circ, const boost::dynamic_bitset<>& input);
+
+    /**
+    * @brief Determines all feasible input patterns that produce the output \p output
+    *
+    * The values of garbage outputs are not observable and hence unknown. All assignments of the
+    * garbage outputs are simulated backwards in bit-parallel blocks, while the non-garbage outputs are
+    * taken from \p output. Every resulting input pattern in which all constant lines hold their constant
+    * value is a preimage of \p output.
+    *
+    * The run-time is exponential in the number of garbage outputs \em g, since all <tt>2^g</tt> assignments
+    * are simulated, as is the number of preimages in the worst case. Circuits with more garbage outputs than
+    * allowed by the setting <tt>max_garbage_lines</tt> are rejected before anything is simulated.
+    *
+    * @param inputs The feasible preimages, in ascending order of the assignment of the garbage outputs
+    * @param circ Circuit to be simulated backwards.
+    * @param output Output pattern. The values of the garbage outputs are ignored.
+    * @param settings <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Setting</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Default Value</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">max_garbage_lines</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">24</td>
+    *     <td class="indexvalue">Maximum number of garbage outputs whose assignments are enumerated. Values above 63 are treated as 63.</td>
+    *   </tr>
+    * </table>
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    * @return true if \p output has at least one feasible preimage
+    *
+    * @throws std::invalid_argument If \p circ has more garbage outputs than <tt>max_garbage_lines</tt>
+    */
+    bool findPreimages(std::vector<boost::dynamic_bitset<>>& inputs, const Circuit& circ, const boost::dynamic_bitset<>& output,
+                       const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
+} // namespace syrec
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Circuit in which runs of linear gates are fused into affine layers
+    *
+    * NOT, CNOT and (uncontrolled) SWAP gates are linear over GF(2): a maximal run of them maps
+    * the line values \em x to <tt>A x + b</tt> for a binary matrix \em A and a constant vector \em b.
+    * Every such run with at least <em>min_run_length</em> gates is replaced by one affine layer,
+    * which stores for every line it changes the set entries of its row of \em A and its constant
+    * bit, unless the layer has at least as many set entries as the run has gates. All remaining gates are kept in a \ref syrec::CompiledCircuit "CompiledCircuit" and
+    * simulated as before.
+    *
+    * On bit-sliced patterns, an affine layer is applied with one word-level XOR per set matrix
+    * entry, so runs of arithmetic produced by synthesis (e.g., additions and bitwise operations)
+    * take far fewer steps than walking their gates.
+    */
+    class FusedCircuit {
+    public:
+        FusedCircuit() = default;
+
+        /**
+        * @brief Fuses the linear runs of \p circ
+        *
+        * @param circ          Circuit to be fused
+        * @param minRunLength  Smallest number of consecutive linear gates that are fused into a layer
+        */
+        explicit FusedCircuit(const Circuit& circ, std::size_t minRunLength = 2U);
+
+        /**
+        * @brief Returns the number of lines
+        */
+        [[nodiscard]] unsigned getLines() const {
+            return gates.getLines();
+        }
+
+        /**
+        * @brief Returns the number of gates that are not part of an affine layer
+        */
+        [[nodiscard]] std::size_t numGates() const {
+            return gates.numGates();
+        }
+
+        /**
+        * @brief Returns the number of affine layers
+        */
+        [[nodiscard]] std::size_t numLayers() const {
+            return layers.size();
+        }
+
+        /**
+        * @brief Returns the number of gates of the original circuit that have been fused into layers
+        */
+        [[nodiscard]] std::size_t numFusedGates() const {
+            return fusedGates;
+        }
+
+        /**
+        * @brief Bit-sliced simulation of one block of patterns
+        *
+        * @param lines One word per circuit line. Bit \em k of each word belongs to pattern \em k.
+        */
+        void simulate(std::vector<PatternWord>& lines) const;
+
+    private:
+        // y[targets[i]] = x[sources[sourceOffsets[i]]] ^ ... ^ x[sources[sourceOffsets[i + 1] - 1]] ^ constants[i]
+        struct AffineLayer {
+            std::vector<CompiledCircuit::line> targets;
+            std::vector<bool>                  constants;
+            std::vector<std::size_t>           sourceOffsets;
+            std::vector<CompiledCircuit::line> sources;
+        };
+
+        // a range of compiled gates, followed by an optional layer
+        struct Step {
+            std::size_t firstGate;
+            std::size_t lastGate;
+            std::size_t layer;
+        };
+
+        CompiledCircuit          gates;
+        std::vector<AffineLayer> layers;
+        std::vector<Step>        steps;
+        std::size_t              fusedGates{};
+    };
+
+    /**
+    * @brief Bit-parallel simulation of a batch of patterns with fused linear layers
+    *
+    * Same as \ref syrec::bitParallelSimulation "bitParallelSimulation", but the circuit is
+    * fused into a FusedCircuit first.
+    *
+    * @param outputs Output patterns. Resized to the number of input patterns.
+    * @param circ Circuit to be simulated.
+    * @param inputs Input patterns. Each pattern must have as many bits as the circuit has lines.
+    * @param settings <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Setting</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Default Value</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">min_run_length</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">2</td>
+    *     <td class="indexvalue">Smallest number of consecutive linear gates that are fused into a layer.</td>
+    *   </tr>
+    * </table>
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">fused_gates</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">Number of gates that have been fused into affine layers.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">layers</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">Number of affine layers.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    *
+    * @throws std::invalid_argument If an input pattern does not have as many bits as the circuit has lines
+    */
+    void fusedSimulation(std::vector<boost::dynamic_bitset<>>& outputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                         const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
+} // namespace syrec
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+
+#include <boost/dynamic_bitset.hpp>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Activity of the gates synthesized from one line of the SyReC source
+    */
+    struct SourceLineActivity {
+        /**
+        * @brief Number of gates annotated with the source line
+        */
+        std::uint64_t gates = 0U;
+
+        /**
+        * @brief Sum of the activations of these gates
+        */
+        std::uint64_t activations = 0U;
+
+        /**
+        * @brief Sum of the line toggles caused by these gates
+        */
+        std::uint64_t toggles = 0U;
+    };
+
+    /**
+    * @brief Activity collected by profilingSimulation
+    */
+    struct SimulationProfile {
+        /**
+        * @brief Number of simulated patterns
+        */
+        std::uint64_t patterns = 0U;
+
+        /**
+        * @brief Per gate, the number of patterns for which all controls were set
+        */
+        std::vector<std::uint64_t> gateActivations;
+
+        /**
+        * @brief Per line, the number of times its value changed, summed over all patterns
+        */
+        std::vector<std::uint64_t> lineToggles;
+
+        /**
+        * @brief Gate activity aggregated by the <em>lno</em> annotation that synthesis attaches to every gate
+        *
+        * Gates without this annotation are not included.
+        */
+        std::map<unsigned, SourceLineActivity> sourceLines;
+    };
+
+    /**
+    * @brief Bit-parallel simulation of a batch of patterns that collects gate and line activity
+    *
+    * Produces the same outputs as \ref syrec::bitParallelSimulation "bitParallelSimulation" and records,
+    * for every gate, how often its control condition was satisfied and, for every line, how often its
+    * value changed. A Toffoli gate changes its target whenever it is activated, a Fredkin gate changes
+    * both targets whenever it is activated and the targets differ.
+    *
+    * The instrumented kernel is a separate instantiation of the bit-sliced simulation, so the
+    * uninstrumented simulation functions are not slowed down by profiling.
+    *
+    * @param profile Collected activity. Overwritten.
+    * @param outputs Output patterns. Resized to the number of input patterns.
+    * @param circ Circuit to be simulated.
+    * @param inputs Input patterns. Each pattern must have as many bits as the circuit has lines.
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    *
+    * @throws std::invalid_argument If an input pattern does not have as many bits as the circuit has lines
+    */
+    void profilingSimulation(SimulationProfile& profile, std::vector<boost::dynamic_bitset<>>& outputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                             const Properties::ptr& statistics = Properties::ptr());
+
+} // namespace syrec
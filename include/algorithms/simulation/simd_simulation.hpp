@@ -0,0 +1,55 @@
+#pragma once
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Instruction set used by the wide bit-sliced simulation kernels
+    */
+    enum class SimdLevel {
+        /** Portable kernel on 64-bit words */
+        Scalar,
+        /** AVX2 kernel, 256 patterns per instruction */
+        AVX2,
+        /** AVX-512 kernel, 512 patterns per instruction */
+        AVX512
+    };
+
+    /**
+    * @brief Returns the widest instruction set supported by the executing CPU
+    *
+    * The CPU features are queried once at run-time. On compilers or architectures
+    * without support for the vectorized kernels, SimdLevel::Scalar is returned.
+    */
+    [[nodiscard]] SimdLevel detectSimdLevel();
+
+    /**
+    * @brief Returns the number of words per line of a bit-sliced block for \p level
+    *
+    * A block holds <tt>simdWordsPerLine(level) * PATTERNS_PER_WORD</tt> patterns,
+    * i.e., 64, 256 and 512 patterns for SimdLevel::Scalar, SimdLevel::AVX2 and SimdLevel::AVX512.
+    */
+    [[nodiscard]] std::size_t simdWordsPerLine(SimdLevel level);
+
+    /**
+    * @brief Bit-sliced simulation of one wide block of patterns on a compiled circuit
+    *
+    * Every line occupies <tt>w = simdWordsPerLine(level)</tt> consecutive words in \p lines,
+    * i.e., pattern \em k of line \em l is bit <tt>k % 64</tt> of word <tt>l * w + k / 64</tt>.
+    * All gates of \p circ are applied to all patterns of the block in place.
+    *
+    * If the CPU does not support \p level, a portable kernel on the same layout is used instead,
+    * so the result does not depend on the executing machine.
+    *
+    * @param lines <tt>circ.getLines() * simdWordsPerLine(level)</tt> words of bit-sliced patterns
+    * @param circ  Compiled circuit to be simulated
+    * @param level Instruction set whose block width determines the layout of \p lines
+    */
+    void simdSimulation(std::vector<PatternWord>& lines, const CompiledCircuit& circ, SimdLevel level);
+
+} // namespace syrec
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "algorithms/simulation/compiled_circuit.hpp"
 #include "core/circuit.hpp"
 #include "core/properties.hpp"
 
 #include <boost/dynamic_bitset.hpp>
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -52,4 +54,78 @@ namespace syrec {
     void simpleSimulation(boost::dynamic_bitset<>& output, const Circuit& circ, const boost::dynamic_bitset<>& input,
                           const Properties::ptr& statistics = Properties::ptr());
 
+    /**
+    * @brief Simple Simulation function for a compiled circuit
+    *
+    * Same as simpleSimulation(boost::dynamic_bitset<>&, const Circuit&, const boost::dynamic_bitset<>&, const Properties::ptr&),
+    * but runs on an already compiled circuit. Use this overload when the same circuit is simulated many times.
+    *
+    * @param output Output pattern. The index of the pattern corresponds to the line index.
+    * @param circ Compiled circuit to be simulated.
+    * @param input Input pattern. The bit-width has to be initialized properly to the number of lines.
+    * @param statistics Same as for the overload taking a Circuit.
+    */
+    void simpleSimulation(boost::dynamic_bitset<>& output, const CompiledCircuit& circ, const boost::dynamic_bitset<>& input,
+                          const Properties::ptr& statistics = Properties::ptr());
+
+    /**
+    * @brief Receiver of the results of exhaustiveSimpleSimulation
+    *
+    * Called once per input with the index of the input (see exhaustiveInputPattern) and the
+    * corresponding output pattern. The output pattern is only valid during the call.
+    */
+    using ExhaustiveSimulationCallback = std::function<void(std::uint64_t input, const boost::dynamic_bitset<>& output)>;
+
+    /**
+    * @brief Simple Simulation of a circuit for all assignments of its primary inputs
+    *
+    * Enumerates all assignments of the non-constant lines, with constant lines fixed to their
+    * values as in exhaustiveInputPattern, and passes every output pattern to \p sink.
+    *
+    * By default, the inputs are visited in Gray-code order, such that two consecutive inputs only
+    * differ in a single line. The state of the lines in front of every <em>checkpoint_interval</em>-th
+    * gate is cached, and after flipping an input line the simulation resumes from the last checkpoint
+    * in front of the first gate on that line instead of from the first gate. The inputs are hence
+    * \b not reported in ascending order.
+    *
+    * @param circ Circuit to be simulated. Must have less than 64 primary inputs.
+    * @param sink Receiver of the simulation results
+    * @param settings <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Setting</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Default Value</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">gray_code</td>
+    *     <td class="indexvalue">bool</td>
+    *     <td class="indexvalue">true</td>
+    *     <td class="indexvalue">Visit the inputs in Gray-code order and simulate incrementally. Otherwise, every input is simulated from the first gate in ascending order.</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">checkpoint_interval</td>
+    *     <td class="indexvalue">unsigned</td>
+    *     <td class="indexvalue">0</td>
+    *     <td class="indexvalue">Number of gates between two cached states. 0 selects an interval such that at most about 1024 states are cached.</td>
+    *   </tr>
+    * </table>
+    * @param statistics <table border="0" width="100%">
+    *   <tr>
+    *     <td class="indexkey">Information</td>
+    *     <td class="indexkey">Type</td>
+    *     <td class="indexkey">Description</td>
+    *   </tr>
+    *   <tr>
+    *     <td class="indexvalue">runtime</td>
+    *     <td class="indexvalue">double</td>
+    *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+    *   </tr>
+    * </table>
+    *
+    * @throws std::invalid_argument If \p circ has 64 or more primary inputs
+    */
+    void exhaustiveSimpleSimulation(const Circuit& circ, const ExhaustiveSimulationCallback& sink,
+                                    const Properties::ptr& settings = Properties::ptr(), const Properties::ptr& statistics = Properties::ptr());
+
 } // namespace syrec
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Key-value annotations of numbered rows, e.g., the gates of a circuit
+    *
+    * Annotations are stored column by column, with one column per key holding a value for every
+    * row. Keys and string values are interned, so a row only costs four bytes per column and equal
+    * values are stored once. Columns whose values have only been set as unsigned integers, like the
+    * <em>lno</em> annotation of synthesis, store the numbers directly and never create strings.
+    */
+    class AnnotationTable {
+    public:
+        using row = std::size_t;
+
+        /**
+        * @brief Sets the annotation \p key of row \p r to \p value, overwriting a previous value
+        */
+        void set(const row r, const std::string& key, const std::string& value) {
+            auto& c = column(key);
+            if (c.integer) {
+                toStrings(c);
+            }
+            cell(c, r) = intern(value);
+        }
+
+        /**
+        * @brief Sets the annotation \p key of row \p r to the unsigned integer \p value
+        */
+        void set(const row r, const std::string& key, const unsigned value) {
+            auto& c = column(key, true);
+            if (!c.integer || value == NONE) {
+                if (c.integer) {
+                    toStrings(c);
+                }
+                cell(c, r) = intern(std::to_string(value));
+                return;
+            }
+            cell(c, r) = value;
+        }
+
+        /**
+        * @brief Returns all annotations of row \p r, or nothing if the row has none
+        */
+        [[nodiscard]] std::optional<std::map<std::string, std::string>> get(const row r) const {
+            std::map<std::string, std::string> annotations;
+            for (const auto& c: columns) {
+                if (const auto v = value(c, r); v != NONE) {
+                    annotations.try_emplace(strings[c.key], c.integer ? std::to_string(v) : strings[v]);
+                }
+            }
+            if (annotations.empty()) {
+                return std::nullopt;
+            }
+            return annotations;
+        }
+
+        /**
+        * @brief Returns the annotation \p key of row \p r
+        */
+        [[nodiscard]] std::optional<std::string> get(const row r, const std::string& key) const {
+            const auto* c = find(key);
+            if (c == nullptr) {
+                return std::nullopt;
+            }
+            const auto v = value(*c, r);
+            if (v == NONE) {
+                return std::nullopt;
+            }
+            return c->integer ? std::to_string(v) : strings[v];
+        }
+
+        /**
+        * @brief Returns the annotation \p key of row \p r if it is an unsigned integer
+        */
+        [[nodiscard]] std::optional<unsigned> getUnsigned(const row r, const std::string& key) const {
+            const auto* c = find(key);
+            if (c == nullptr) {
+                return std::nullopt;
+            }
+            const auto v = value(*c, r);
+            if (v == NONE) {
+                return std::nullopt;
+            }
+            if (c->integer) {
+                return v;
+            }
+            const auto& s = strings[v];
+            unsigned    n{};
+            const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), n);
+            if (ec != std::errc() || end != s.data() + s.size()) {
+                return std::nullopt;
+            }
+            return n;
+        }
+
+        /**
+        * @brief Copies the annotations of row \p fromRow of \p from to row \p r
+        */
+        void copyRow(const row r, const AnnotationTable& from, const row fromRow) {
+            for (const auto& c: from.columns) {
+                if (const auto v = value(c, fromRow); v != NONE) {
+                    if (c.integer) {
+                        set(r, from.strings[c.key], v);
+                    } else {
+                        set(r, from.strings[c.key], from.strings[v]);
+                    }
+                }
+            }
+        }
+
+        /**
+        * @brief Moves all annotations of \p other into this table, shifting their rows by \p offset
+        *
+        * The rows of \p other must not overlap the annotated rows of this table. This takes time linear
+        * in the rows and distinct strings of \p other, which is left empty.
+        */
+        void append(AnnotationTable&& other, const row offset) {
+            std::vector<std::uint32_t> remap(other.strings.size(), NONE);
+            const auto                 translate = [&](const std::uint32_t id) {
+                if (remap[id] == NONE) {
+                    remap[id] = intern(other.strings[id]);
+                }
+                return remap[id];
+            };
+
+            for (auto& src: other.columns) {
+                if (src.values.empty()) {
+                    continue;
+                }
+                auto& dst = column(other.strings[src.key], src.integer);
+                if (dst.integer && !src.integer) {
+                    toStrings(dst);
+                }
+                dst.values.resize(std::max(dst.values.size(), offset + src.values.size()), NONE);
+                for (std::size_t i = 0U; i < src.values.size(); ++i) {
+                    auto v = src.values[i];
+                    if (v == NONE) {
+                        continue;
+                    }
+                    if (!src.integer) {
+                        v = translate(v);
+                    } else if (!dst.integer) {
+                        v = intern(std::to_string(v));
+                    }
+                    dst.values[offset + i] = v;
+                }
+            }
+            other = AnnotationTable();
+        }
+
+    private:
+        static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+        struct Column {
+            std::uint32_t key;
+            // values are numbers instead of string ids
+            bool                       integer;
+            std::vector<std::uint32_t> values;
+        };
+
+        std::uint32_t intern(const std::string& s) {
+            const auto [it, inserted] = stringIds.try_emplace(s, static_cast<std::uint32_t>(strings.size()));
+            if (inserted) {
+                strings.emplace_back(s);
+            }
+            return it->second;
+        }
+
+        [[nodiscard]] const Column* find(const std::string& key) const {
+            const auto it = stringIds.find(key);
+            if (it == stringIds.end()) {
+                return nullptr;
+            }
+            for (const auto& c: columns) {
+                if (c.key == it->second) {
+                    return &c;
+                }
+            }
+            return nullptr;
+        }
+
+        // finds or creates the column of key, new columns are integer columns if requested
+        Column& column(const std::string& key, const bool integer = false) {
+            const auto id = intern(key);
+            for (auto& c: columns) {
+                if (c.key == id) {
+                    return c;
+                }
+            }
+            return columns.emplace_back(Column{id, integer, {}});
+        }
+
+        void toStrings(Column& c) {
+            for (auto& v: c.values) {
+                if (v != NONE) {
+                    v = intern(std::to_string(v));
+                }
+            }
+            c.integer = false;
+        }
+
+        static std::uint32_t& cell(Column& c, const row r) {
+            if (r >= c.values.size()) {
+                c.values.resize(r + 1U, NONE);
+            }
+            return c.values[r];
+        }
+
+        static std::uint32_t value(const Column& c, const row r) {
+            return r < c.values.size() ? c.values[r] : NONE;
+        }
+
+        std::vector<std::string>                       strings;
+        std::unordered_map<std::string, std::uint32_t> stringIds;
+        std::vector<Column>                            columns;
+    };
+
+} // namespace syrec
@@ -1,15 +1,27 @@
 #pragma once
 
+#include "core/annotation_table.hpp"
+#include "core/circuit_metrics.hpp"
+#include "core/gate_dependencies.hpp"
+#include "core/utils/arena.hpp"
+#include "core/utils/cache_mutex.hpp"
+#include "core/utils/chunked_writer.hpp"
 #include "gate.hpp"
 
-#include <boost/signals2.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <ostream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace syrec {
     /**
@@ -17,6 +29,53 @@ namespace syrec {
    */
     using constant = std::optional<bool>;
 
+    /**
+     * @brief Callbacks which are invoked for every gate added to a circuit
+     *
+     * Connected callbacks are called in the order of connection. Invoking the hook only checks
+     * whether a callback is connected, so circuits without callbacks add gates at no extra cost.
+     */
+    class GateAddedHook {
+    public:
+        using slot_type = std::function<void(Gate&)>;
+
+        /**
+         * @brief Connects a callback, which is invoked with every added gate
+         */
+        void connect(slot_type slot) {
+            slots.emplace_back(std::move(slot));
+        }
+
+        /**
+         * @brief Disconnects all callbacks
+         */
+        void disconnectAllSlots() {
+            slots.clear();
+        }
+
+        /**
+         * @brief Returns whether no callback is connected
+         */
+        [[nodiscard]] bool empty() const {
+            return slots.empty();
+        }
+
+        void operator()(Gate& g) const {
+            if (!slots.empty()) {
+                emit(g);
+            }
+        }
+
+    private:
+        void emit(Gate& g) const {
+            for (const auto& slot: slots) {
+                slot(g);
+            }
+        }
+
+        std::vector<slot_type> slots;
+    };
+
     /**
    * @brief Main circuit class
    */
@@ -31,15 +90,30 @@ namespace syrec {
         Circuit()  = default;
         ~Circuit() = default;
 
+        /**
+         * @brief Instance of a shared sub-circuit
+         *
+         * All gates of the sub-circuit are placed at the position of the instance, with line \em i of the
+         * sub-circuit mapped to <tt>lines[i]</tt>. An inverted instance applies the gates in reverse order,
+         * which is the inverse since all gates are self-inverse.
+         */
+        struct Instance {
+            std::shared_ptr<const Circuit> circ;
+            std::vector<Gate::line>        lines;
+            bool                           inverted = false;
+            // number of gates of the circuit in front of the instance
+            std::size_t position = 0U;
+        };
+
         /**
          * @brief Returns the number of gates
          *
-         * This method returns the number of gates in the circuit.
+         * This method returns the number of gates in the circuit, including the gates of all instances.
          *
          * @return Number of gates
          */
-        [[nodiscard]] auto numGates() const {
-            return gates.size();
+        [[nodiscard]] std::size_t numGates() const {
+            return gates.size() + instanceGates;
         }
 
         /**
@@ -79,37 +153,75 @@ namespace syrec {
         /**
          * @brief Constant begin iterator pointing to gates
          *
+         * The circuit must not have instances, see flatten().
+         *
          * @return Constant begin iterator
+         *
+         * @throws std::logic_error If the circuit has instances
          */
         [[nodiscard]] auto cbegin() const {
+            requireFlat();
             return gates.cbegin();
         }
 
         /**
          * @brief Begin iterator pointing to gates
          *
+         * The circuit must not have instances, see flatten().
+         *
          * @return Begin iterator
+         *
+         * @throws std::logic_error If the circuit has instances
          */
         [[nodiscard]] auto begin() const {
-            return gates.begin();
+            return cbegin();
+        }
+
+        /**
+         * @brief Begin iterator pointing to gates, instances are flattened first
+         *
+         * @return Begin iterator
+         */
+        [[nodiscard]] auto begin() {
+            flatten();
+            return gates.cbegin();
         }
 
         /**
          * @brief Constant end iterator pointing to gates
          *
+         * The circuit must not have instances, see flatten().
+         *
          * @return Constant end iterator
+         *
+         * @throws std::logic_error If the circuit has instances
          */
         [[nodiscard]] auto cend() const {
+            requireFlat();
             return gates.cend();
         }
 
         /**
          * @brief End iterator pointing to gates
          *
+         * The circuit must not have instances, see flatten().
+         *
          * @return End iterator
+         *
+         * @throws std::logic_error If the circuit has instances
          */
         [[nodiscard]] auto end() const {
-            return gates.end();
+            return cend();
+        }
+
+        /**
+         * @brief End iterator pointing to gates, instances are flattened first
+         *
+         * @return End iterator
+         */
+        [[nodiscard]] auto end() {
+            flatten();
+            return gates.cend();
         }
 
         /**
@@ -120,9 +232,10 @@ namespace syrec {
      * @return Reference to the newly created empty gate
      */
         Gate& appendGate() {
-            gates.emplace_back(std::make_shared<Gate>());
-            gateAdded(*gates.back());
-            return *gates.back();
+            Gate& g = gateStore.emplace();
+            gates.emplace_back(&g);
+            gateAdded(g);
+            return g;
         }
 
         /**
@@ -135,9 +248,12 @@ namespace syrec {
      * @return Reference to the newly created empty gate
      */
         Gate& insertGate(unsigned pos) {
-            auto ins = gates.insert(gates.begin() + pos, std::make_shared<Gate>());
-            gateAdded(**ins);
-            return **ins;
+            flatten();
+            Gate& g = gateStore.emplace();
+            invalidateAnalyses(pos);
+            gates.insert(gates.begin() + pos, &g);
+            gateAdded(g);
+            return g;
         }
 
         /**
@@ -274,13 +390,48 @@ namespace syrec {
      *
      * @param g Gate
      *
-     * @return Map of annotations encapsulated in an optional
+     * @return Map of annotations encapsulated in an optional, empty if \p g is not a gate of this circuit
      */
         [[nodiscard]] std::optional<const std::map<std::string, std::string>> getAnnotations(const Gate& g) const {
-            if (auto it = annotations.find(&g); it != annotations.end()) {
-                return {it->second};
+            const auto row = gateStore.indexOf(g);
+            if (!row) {
+                return std::nullopt;
             }
-            return {};
+            return annotations.get(*row);
+        }
+
+        /**
+     * @brief Returns a single annotation of a gate
+     *
+     * @param g Gate
+     * @param key Key of the annotation
+     *
+     * @return Value of the annotation if \p g is a gate of this circuit and has one for \p key
+     */
+        [[nodiscard]] std::optional<std::string> getAnnotation(const Gate& g, const std::string& key) const {
+            const auto row = gateStore.indexOf(g);
+            if (!row) {
+                return std::nullopt;
+            }
+            return annotations.get(*row, key);
+        }
+
+        /**
+     * @brief Returns a single annotation of a gate as unsigned integer
+     *
+     * This is the fast path for numeric annotations such as the line number <em>lno</em> set by synthesis.
+     *
+     * @param g Gate
+     * @param key Key of the annotation
+     *
+     * @return Value of the annotation if \p g is a gate of this circuit and has one for \p key that is an unsigned integer
+     */
+        [[nodiscard]] std::optional<unsigned> getUnsignedAnnotation(const Gate& g, const std::string& key) const {
+            const auto row = gateStore.indexOf(g);
+            if (!row) {
+                return std::nullopt;
+            }
+            return annotations.getUnsigned(*row, key);
         }
 
         /**
@@ -292,9 +443,27 @@ namespace syrec {
      * @param g Gate
      * @param key Key of the annotation
      * @param value Value of the annotation
+     *
+     * @throws std::invalid_argument If \p g is not a gate of this circuit
      */
         void annotate(const Gate& g, const std::string& key, const std::string& value) {
-            annotations[&g][key] = value;
+            annotations.set(annotationRow(g), key, value);
+        }
+
+        /**
+     * @brief Annotates a gate with an unsigned integer
+     *
+     * Same as annotating the decimal representation of \p value, but numeric annotations are stored
+     * without creating strings.
+     *
+     * @param g Gate
+     * @param key Key of the annotation
+     * @param value Value of the annotation
+     *
+     * @throws std::invalid_argument If \p g is not a gate of this circuit
+     */
+        void annotate(const Gate& g, const std::string& key, const unsigned value) {
+            annotations.set(annotationRow(g), key, value);
         }
 
         /**
@@ -323,39 +492,66 @@ namespace syrec {
 
         ///add circuit
 
+        /**
+         * @brief Inserts a copy of all gates of \p src
+         *
+         * The gates are copied with their annotations and \p controls are added to their controls.
+         * All copies are inserted at \p pos at once.
+         *
+         * @param pos Position where to insert the gates
+         * @param src Circuit whose gates are copied
+         * @param controls Additional controls of all inserted gates
+         */
         void insertCircuit(unsigned pos, const Circuit& src, const Gate::line_container& controls) {
-            if (controls.empty()) {
-                for (const auto& g: src) {
-                    Gate& newGate = insertGate(pos++);
-                    newGate       = *g;
-                    auto anno     = src.getAnnotations(*g);
-                    if (anno) {
-                        for (const auto& [first, second]: *anno) {
-                            annotate(newGate, first, second);
-                        }
-                    }
+            flatten();
+            std::vector<Gate*> inserted;
+            inserted.reserve(src.numGates());
+            // the instances of src are copied as well, without expanding them in src
+            src.walk([&](const Gate& g, const Circuit& owner, const Gate& original) {
+                Gate& newGate = gateStore.emplace();
+                gateAdded(newGate);
+                newGate = g;
+                newGate.controls.insert(controls.begin(), controls.end());
+                if (const auto row = owner.gateStore.indexOf(original)) {
+                    annotations.copyRow(gateStore.size() - 1U, owner.annotations, *row);
                 }
-            } else {
-                for (const auto& g: src) {
-                    Gate& newGate = insertGate(pos++);
-                    for (const auto& control: controls) {
-                        newGate.controls.emplace(control);
-                    }
-                    for (const auto& c: g->controls) {
-                        newGate.controls.emplace(c);
-                    }
-                    for (const auto& t: g->targets) {
-                        newGate.targets.emplace(t);
-                    }
-                    newGate.type = g->type;
-                    auto anno    = src.getAnnotations(*g);
-                    if (anno) {
-                        for (const auto& [first, second]: *anno) {
-                            annotate(newGate, first, second);
-                        }
-                    }
+                inserted.emplace_back(&newGate);
+            },
+                     nullptr, false);
+            invalidateAnalyses(pos);
+            gates.insert(gates.begin() + pos, inserted.cbegin(), inserted.cend());
+        }
+
+        /**
+         * @brief Moves all gates of \p src into the circuit
+         *
+         * The gates and their annotations change hands without being copied, so the gates keep their
+         * addresses and this takes time linear in the number of gates of \p src (plus shifting the gates
+         * behind \p pos once). \p controls are added to the controls of the moved gates in place.
+         * The gateAdded hook is not invoked. Afterwards, \p src has no gates.
+         *
+         * @param pos Position where to insert the gates
+         * @param src Circuit whose gates are moved
+         * @param controls Additional controls of all inserted gates
+         */
+        void insertCircuit(unsigned pos, Circuit&& src, const Gate::line_container& controls) {
+            if (&src == this) {
+                return;
+            }
+            flatten();
+            src.flatten();
+            if (!controls.empty()) {
+                for (auto* g: src.gates) {
+                    g->controls.insert(controls.begin(), controls.end());
                 }
             }
+            invalidateAnalyses(pos);
+            gates.insert(gates.begin() + pos, src.gates.cbegin(), src.gates.cend());
+            src.gates.clear();
+            src.invalidateAnalyses(0U);
+            // the gates of src are appended to the gate store, so their rows move behind the existing ones
+            annotations.append(std::move(src.annotations), gateStore.size());
+            gateStore.splice(std::move(src.gateStore));
         }
 
         ///add gates
@@ -402,30 +598,223 @@ namespace syrec {
             return g;
         }
 
-        // SIGNALS
+        // HIERARCHY
         /**
-     * @brief Signal which is emitted after adding a gate
+         * @brief Appends an instance of the sub-circuit \p sub
+         *
+         * The gates of \p sub are not copied, so a sub-circuit instantiated many times is stored only once.
+         * Costs, depth, dependencies, forEachGate(), toQasm(), and CompiledCircuit, on which most simulations run,
+         * work on the hierarchy directly. Functions accessing single gates need a flat circuit: the non-const ones,
+         * such as begin() or insertGate(), expand the instances into copies of their gates first, all others, such as
+         * the const iterators and the writers taking a const circuit, require flatten() to be called before.
+         * \p sub must not be modified while it is instantiated.
+         *
+         * @param sub Sub-circuit
+         * @param mapping Line of this circuit for every line of \p sub
+         * @param inverted If true, the gates of \p sub are applied in reverse order, e.g., for an uncall
+         *
+         * @throws std::invalid_argument If \p sub is null or this circuit, or if \p mapping does not assign distinct
+         * lines of this circuit to all lines of \p sub
+         */
+        void appendInstance(std::shared_ptr<const Circuit> sub, std::vector<Gate::line> mapping, const bool inverted = false) {
+            if (!sub) {
+                throw std::invalid_argument("The sub-circuit must not be null");
+            }
+            if (sub.get() == this) {
+                throw std::invalid_argument("A circuit cannot instantiate itself");
+            }
+            if (mapping.size() != sub->getLines()) {
+                throw std::invalid_argument("The mapping must assign a line to every line of the sub-circuit");
+            }
+            std::vector<bool> used(lines, false);
+            for (const auto l: mapping) {
+                if (l >= lines || used[l]) {
+                    throw std::invalid_argument("The mapping must assign distinct lines of the circuit");
+                }
+                used[l] = true;
+            }
+            instanceGates += sub->numGates();
+            instances.emplace_back(Instance{std::move(sub), std::move(mapping), inverted, gates.size()});
+        }
+
+        /**
+         * @brief Returns the instances which have not been expanded, in circuit order
+         */
+        [[nodiscard]] const std::vector<Instance>& getInstances() const {
+            return instances;
+        }
+
+        /**
+         * @brief Replaces all instances by copies of their gates
+         *
+         * The copies keep the annotations of the original gates, the gateAdded hook is not invoked.
+         * The non-const functions accessing single gates, such as begin(), insertGate(), or insertCircuit(),
+         * flatten the circuit implicitly. The const iterators never modify the circuit, so a circuit with
+         * instances must be flattened before iterating over it through a const reference.
+         */
+        void flatten() {
+            if (instances.empty()) {
+                return;
+            }
+            std::vector<Gate*> flat;
+            flat.reserve(numGates());
+            auto next = instances.cbegin();
+            for (std::size_t i = 0U; i <= gates.size(); ++i) {
+                for (; next != instances.cend() && next->position == i; ++next) {
+                    next->circ->walk([&](const Gate& g, const Circuit& owner, const Gate& original) {
+                        Gate& copy = gateStore.emplace();
+                        copy       = g;
+                        if (const auto row = owner.gateStore.indexOf(original)) {
+                            annotations.copyRow(gateStore.size() - 1U, owner.annotations, *row);
+                        }
+                        flat.emplace_back(&copy);
+                    },
+                                     &next->lines, next->inverted);
+                }
+                if (i < gates.size()) {
+                    flat.emplace_back(gates[i]);
+                }
+            }
+            // the counted gates and instances precede all others, so they become the first gates
+            for (std::size_t i = 0U; i < metricsInstances; ++i) {
+                metricsGates += instances[i].circ->numGates();
+            }
+            for (std::size_t i = 0U; i < dependencyInstances; ++i) {
+                dependencyGates += instances[i].circ->numGates();
+            }
+            metricsInstances    = 0U;
+            dependencyInstances = 0U;
+            gates               = std::move(flat);
+            instances.clear();
+            instanceGates = 0U;
+        }
+
+        /**
+         * @brief Calls \p visit with every gate in circuit order without expanding instances
+         *
+         * Gates of instances are passed as temporary copies acting on the lines of this circuit.
+         *
+         * @param visit Callable taking a <tt>const Gate&</tt>
+         */
+        template<typename Visitor>
+        void forEachGate(Visitor&& visit) const {
+            walk([&visit](const Gate& g, const Circuit& /*owner*/, const Gate& /*original*/) { visit(g); }, nullptr, false);
+        }
+
+        /**
+         * @brief Calls \p visit with every gate in circuit order together with the gate it originates from
+         *
+         * Like forEachGate(), but \p visit additionally receives the circuit owning the gate and the gate
+         * itself, which differ from this circuit and the passed gate for gates of instances. They give
+         * access to the annotations of the gate, e.g., <tt>owner.getAnnotations(original)</tt>.
+         *
+         * @param visit Callable taking a <tt>const Gate&</tt>, a <tt>const Circuit&</tt>, and a <tt>const Gate&</tt>
+         */
+        template<typename Visitor>
+        void forEachGateWithOrigin(Visitor&& visit) const {
+            walk(visit, nullptr, false);
+        }
+
+        // HOOKS
+        /**
+     * @brief Hook which is invoked after adding a gate
      *
      * The gate is always empty, since when adding a gate to the
      * circuit an empty gate is returned as reference and then
      * further processed by functions such as append_toffoli.
      */
-        boost::signals2::signal<void(Gate&)> gateAdded; //NOLINT(cppcoreguidelines-pro-type-member-init)
+        GateAddedHook gateAdded;
 
-        [[nodiscard]] Gate::cost_t quantumCost() const {
-            Gate::cost_t cost = 0U;
-            for (const auto& g: gates) {
-                cost += g->quantumCost(lines);
+        // METRICS
+        /**
+         * @brief Returns the cost and gate histogram of the circuit
+         *
+         * The metrics are maintained incrementally: gates added since the last call are counted
+         * once, gates inserted in front of counted gates cause a recount on the next call. Gates
+         * modified in place after having been counted are not noticed, use recomputeMetrics()
+         * afterwards. Instances are counted from the metrics of their sub-circuits in time independent
+         * of their number of gates. The update on access is guarded by a mutex, so a circuit that is not
+         * modified meanwhile, e.g., a sub-circuit shared by several instances, can be queried from several
+         * threads at once.
+         *
+         * @return Metrics of all gates of the circuit
+         */
+        [[nodiscard]] const CircuitMetrics& getMetrics() const {
+            const std::lock_guard<CacheMutex> lock(analysisMutex);
+            if (metricsGates < gates.size() || metricsInstances < instances.size()) {
+                foldMetrics();
             }
-            return cost;
+            return metrics;
         }
 
-        [[nodiscard]] Gate::cost_t transistorCost() const {
-            Gate::cost_t cost = 0U;
-            for (const auto& g: gates) {
-                cost += (8ULL * g->controls.size());
+        /**
+         * @brief Recounts the metrics of all gates
+         *
+         * The dependencies are rebuilt on their next access as well, such that the depth reflects gates
+         * modified in place, too.
+         *
+         * @param nThreads Number of threads used for counting. 0 selects the number of available cores.
+         */
+        void recomputeMetrics(const unsigned nThreads = 0U) {
+            dependencies.clear();
+            dependencyGates     = 0U;
+            dependencyInstances = 0U;
+            if (!instances.empty()) {
+                metrics.clear();
+                metricsGates     = 0U;
+                metricsInstances = 0U;
+                foldMetrics();
+                return;
             }
-            return cost;
+            metrics      = CircuitMetrics::compute(gates.cbegin(), gates.cend(), nThreads);
+            metricsGates = gates.size();
+        }
+
+        /**
+         * @brief Returns the line occupancy and dependencies of the gates
+         *
+         * Gates are identified by their position in the circuit. The index is built in one pass on first
+         * access and then kept up to date like the metrics (see getMetrics()): gates added since the last
+         * call are appended to it, gates inserted in front of indexed gates cause a rebuild on the next call.
+         * Circuits on which it is never requested do not pay for it. Lines of gates changed in place after
+         * having been indexed are not noticed, use rebuildDependencies() afterwards. Like getMetrics(),
+         * this can be called from several threads at once.
+         *
+         * @return Dependencies of all gates of the circuit
+         */
+        [[nodiscard]] const GateDependencies& getDependencies() const {
+            const std::lock_guard<CacheMutex> lock(analysisMutex);
+            if (dependencyGates < gates.size() || dependencyInstances < instances.size()) {
+                foldDependencies();
+            }
+            return dependencies;
+        }
+
+        /**
+         * @brief Rebuilds the dependencies of all gates, e.g., after modifying gates in place
+         */
+        void rebuildDependencies() {
+            dependencies.clear();
+            dependencyGates     = 0U;
+            dependencyInstances = 0U;
+            foldDependencies();
+        }
+
+        [[nodiscard]] Gate::cost_t quantumCost() const {
+            return getMetrics().quantumCost(lines);
+        }
+
+        [[nodiscard]] Gate::cost_t transistorCost() const {
+            return getMetrics().transistorCost();
+        }
+
+        /**
+         * @brief Returns the depth of the circuit
+         *
+         * The depth is the number of ASAP layers of the gate dependencies, see getDependencies().
+         */
+        [[nodiscard]] std::size_t depth() const {
+            return getDependencies().depth();
         }
 
         /**
@@ -433,32 +822,177 @@ namespace syrec {
          * @return QASM string
          */
         [[nodiscard]] std::string toQasm() const {
-            std::stringstream ss;
-            ss << "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[" << lines << "];\n";
-            for (const auto& g: gates) {
-                ss << g->toQasm() << "\n";
+            std::string qasm = qasmHeader();
+            forEachGate([&qasm](const Gate& g) {
+                g.appendQasm(qasm);
+                qasm += '\n';
+            });
+            return qasm;
+        }
+
+        /**
+         * @brief Write circuit to QASM stream.
+         *
+         * The gates are formatted through a reusable buffer, so the QASM representation of the whole circuit
+         * is never held in memory.
+         *
+         * @param os Stream to write to
+         * @param nThreads Number of threads formatting chunks of gates concurrently, the output does not depend on it.
+         * 0 selects the number of available cores. Circuits with instances are formatted on the calling thread.
+         */
+        void toQasm(std::ostream& os, const unsigned nThreads = 1U) const {
+            os << qasmHeader();
+            if (!instances.empty()) {
+                std::string buffer;
+                forEachGate([&os, &buffer](const Gate& g) {
+                    g.appendQasm(buffer);
+                    buffer += '\n';
+                    if (buffer.size() >= (1U << 16U)) {
+                        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                        buffer.clear();
+                    }
+                });
+                os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                return;
             }
-            return ss.str();
+            writeChunked(os, gates.cbegin(), gates.cend(), nThreads, [](std::string& buffer, const Gate* g) {
+                g->appendQasm(buffer);
+                buffer += '\n';
+            });
         }
 
         /**
          * @brief Write circuit to QASM file.
          * @param filename Filename (should end with .qasm)
+         * @param nThreads Number of threads formatting chunks of gates concurrently, see toQasm(std::ostream&, unsigned)
          * @return True if successful, false otherwise
          */
-        [[nodiscard]] bool toQasmFile(const std::string& filename) const {
+        [[nodiscard]] bool toQasmFile(const std::string& filename, const unsigned nThreads = 1U) const {
             std::ofstream file(filename);
             if (!file.is_open()) {
                 return false; // GCOVR_EXCL_LINE
             }
-            file << toQasm();
+            toQasm(file, nThreads);
             file.close();
             return true;
         }
 
     private:
-        std::vector<std::shared_ptr<Gate>> gates{};
-        unsigned                           lines{};
+        [[nodiscard]] std::string qasmHeader() const {
+            return "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[" + std::to_string(lines) + "];\n";
+        }
+
+        void requireFlat() const {
+            if (!instances.empty()) {
+                throw std::logic_error("The circuit must be flattened before iterating over its gates");
+            }
+        }
+
+        // annotation row of a gate of this circuit
+        [[nodiscard]] AnnotationTable::row annotationRow(const Gate& g) const {
+            const auto row = gateStore.indexOf(g);
+            if (!row) {
+                throw std::invalid_argument("Only gates of this circuit can be annotated");
+            }
+            return *row;
+        }
+
+        // counts the gates and instances behind the ones counted so far, instances at position p come before gate p
+        // callers hold analysisMutex or have exclusive access through a non-const function
+        void foldMetrics() const {
+            while (metricsGates < gates.size() || metricsInstances < instances.size()) {
+                if (metricsInstances < instances.size() && instances[metricsInstances].position <= metricsGates) {
+                    const auto& instance = instances[metricsInstances++];
+                    metrics.merge(instance.circ->getMetrics());
+                } else {
+                    metrics.add(*gates[metricsGates++]);
+                }
+            }
+        }
+
+        // indexes the gates and the gates of instances behind the ones indexed so far, in the same order as foldMetrics
+        void foldDependencies() const {
+            while (dependencyGates < gates.size() || dependencyInstances < instances.size()) {
+                if (dependencyInstances < instances.size() && instances[dependencyInstances].position <= dependencyGates) {
+                    const auto& instance = instances[dependencyInstances++];
+                    instance.circ->walk([this](const Gate& g, const Circuit& /*owner*/, const Gate& /*original*/) { dependencies.add(g); }, &instance.lines, instance.inverted);
+                } else {
+                    dependencies.add(*gates[dependencyGates++]);
+                }
+            }
+        }
+
+        // visits all gates in order, or in reverse order if inverted, gates of instances are mapped to the lines of the outermost circuit
+        template<typename Visitor>
+        void walk(Visitor&& visit, const std::vector<Gate::line>* mapping, const bool inverted) const {
+            Gate       mapped;
+            const auto visitGate = [&](const Gate& g) {
+                if (mapping == nullptr) {
+                    visit(g, *this, g);
+                    return;
+                }
+                mapped.type = g.type;
+                mapped.controls.clear();
+                mapped.targets.clear();
+                for (const auto c: g.controls) {
+                    mapped.controls.insert((*mapping)[c]);
+                }
+                for (const auto t: g.targets) {
+                    mapped.targets.insert((*mapping)[t]);
+                }
+                visit(mapped, *this, g);
+            };
+            const auto visitInstance = [&](const Instance& instance) {
+                if (mapping == nullptr) {
+                    instance.circ->walk(visit, &instance.lines, inverted != instance.inverted);
+                    return;
+                }
+                std::vector<Gate::line> composed(instance.lines.size());
+                std::transform(instance.lines.cbegin(), instance.lines.cend(), composed.begin(), [mapping](const auto l) { return (*mapping)[l]; });
+                instance.circ->walk(visit, &composed, inverted != instance.inverted);
+            };
+
+            if (!inverted) {
+                auto next = instances.cbegin();
+                for (std::size_t i = 0U; i <= gates.size(); ++i) {
+                    for (; next != instances.cend() && next->position == i; ++next) {
+                        visitInstance(*next);
+                    }
+                    if (i < gates.size()) {
+                        visitGate(*gates[i]);
+                    }
+                }
+            } else {
+                auto next = instances.crbegin();
+                for (std::size_t i = gates.size() + 1U; i-- > 0U;) {
+                    for (; next != instances.crend() && next->position == i; ++next) {
+                        visitInstance(*next);
+                    }
+                    if (i > 0U) {
+                        visitGate(*gates[i - 1U]);
+                    }
+                }
+            }
+        }
+
+        // gates are inserted at pos, so the analyses of the gates behind pos no longer match
+        void invalidateAnalyses(const std::size_t pos) {
+            if (pos < metricsGates) {
+                metrics.clear();
+                metricsGates     = 0U;
+                metricsInstances = 0U;
+            }
+            if (pos < dependencyGates) {
+                dependencies.clear();
+                dependencyGates     = 0U;
+                dependencyInstances = 0U;
+            }
+        }
+
+        // the gates are owned by the arena, which never moves them, and referenced in circuit order
+        Arena<Gate>        gateStore{};
+        std::vector<Gate*> gates{};
+        unsigned           lines{};
 
         std::vector<std::string> inputs{};
         std::vector<std::string> outputs{};
@@ -466,7 +1000,25 @@ namespace syrec {
         std::vector<bool>        garbage{};
         std::string              name{};
 
-        std::map<const Gate*, std::map<std::string, std::string>> annotations;
+        // rows are the indices of the gates in the gate store
+        AnnotationTable annotations;
+
+        // instances which have not been expanded yet, ordered by position
+        std::vector<Instance> instances{};
+        std::size_t           instanceGates = 0U;
+
+        // metrics of the first metricsGates gates, the gates behind are counted on access
+        mutable CircuitMetrics metrics;
+        mutable std::size_t    metricsGates     = 0U;
+        mutable std::size_t    metricsInstances = 0U;
+
+        // dependencies of the first dependencyGates gates and dependencyInstances instances, only built on request
+        mutable GateDependencies dependencies;
+        mutable std::size_t      dependencyGates     = 0U;
+        mutable std::size_t      dependencyInstances = 0U;
+
+        // guards the folding of gates into the metrics and dependencies on access
+        mutable CacheMutex analysisMutex;
     };
 
 } // namespace syrec
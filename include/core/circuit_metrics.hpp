@@ -0,0 +1,153 @@
+#pragma once
+
+#include "core/gate.hpp"
+#include "core/utils/work_stealing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Cost and gate histogram of a sequence of gates
+    *
+    * Gates are counted by type and number of controls. Both costs only depend on these two
+    * numbers (and the number of lines of the circuit), so they are derived from the histogram
+    * in time independent of the number of gates, also when lines are added after the gates.
+    * The counts do not depend on the order of the gates. The depth does, and is taken from the
+    * layers of a \ref syrec::GateDependencies "GateDependencies" index instead.
+    */
+    class CircuitMetrics {
+    public:
+        /**
+        * @brief Number of gates by type and number of controls
+        */
+        using histogram = std::map<std::pair<Gate::Types, std::size_t>, std::size_t>;
+
+        /**
+        * @brief Adds \p g to the counts
+        */
+        void add(const Gate& g) {
+            const auto c = g.controls.size();
+            if (c >= counts.size()) {
+                counts.resize(c + 1U, {});
+            }
+            ++counts[c][static_cast<std::size_t>(g.type)];
+        }
+
+        /**
+        * @brief Adds the counts of \p other to the histogram
+        */
+        void merge(const CircuitMetrics& other) {
+            if (counts.size() < other.counts.size()) {
+                counts.resize(other.counts.size(), {});
+            }
+            for (std::size_t c = 0U; c < other.counts.size(); ++c) {
+                for (std::size_t t = 0U; t < NTYPES; ++t) {
+                    counts[c][t] += other.counts[c][t];
+                }
+            }
+        }
+
+        /**
+        * @brief Removes all gates
+        */
+        void clear() {
+            counts.clear();
+        }
+
+        /**
+        * @brief Returns the quantum cost of the gates in a circuit with \p lines lines
+        */
+        [[nodiscard]] Gate::cost_t quantumCost(const unsigned lines) const {
+            Gate::cost_t cost = 0U;
+            for (std::size_t c = 0U; c < counts.size(); ++c) {
+                for (std::size_t t = 0U; t < NTYPES; ++t) {
+                    if (counts[c][t] != 0U) {
+                        cost += counts[c][t] * Gate::quantumCost(static_cast<Gate::Types>(t), c, lines);
+                    }
+                }
+            }
+            return cost;
+        }
+
+        /**
+        * @brief Returns the transistor cost of the gates
+        */
+        [[nodiscard]] Gate::cost_t transistorCost() const {
+            Gate::cost_t cost = 0U;
+            for (std::size_t c = 0U; c < counts.size(); ++c) {
+                for (const auto n: counts[c]) {
+                    cost += 8ULL * c * n;
+                }
+            }
+            return cost;
+        }
+
+        /**
+        * @brief Returns the number of gates of type \p type with \p nControls controls
+        */
+        [[nodiscard]] std::size_t numGates(const Gate::Types type, const std::size_t nControls) const {
+            return nControls < counts.size() ? counts[nControls][static_cast<std::size_t>(type)] : 0U;
+        }
+
+        /**
+        * @brief Returns the number of gates for every occurring combination of type and number of controls
+        */
+        [[nodiscard]] histogram gateHistogram() const {
+            histogram h;
+            for (std::size_t c = 0U; c < counts.size(); ++c) {
+                for (std::size_t t = 0U; t < NTYPES; ++t) {
+                    if (counts[c][t] != 0U) {
+                        h.try_emplace({static_cast<Gate::Types>(t), c}, counts[c][t]);
+                    }
+                }
+            }
+            return h;
+        }
+
+        /**
+        * @brief Computes the metrics of the gates <tt>[first, last)</tt>
+        *
+        * The histogram is counted in chunks on up to \p nThreads threads.
+        *
+        * @param first Iterator to the first gate, dereferencing to a pointer to a gate
+        * @param last Iterator behind the last gate
+        * @param nThreads Number of threads. 0 selects the number of available cores.
+        */
+        template<typename GateIt>
+        [[nodiscard]] static CircuitMetrics compute(const GateIt first, const GateIt last, const unsigned nThreads = 0U) {
+            constexpr std::size_t chunkSize = 4096U;
+
+            const auto                  nGates  = static_cast<std::size_t>(std::distance(first, last));
+            const auto                  nChunks = (nGates + chunkSize - 1U) / chunkSize;
+            const auto                  threads = static_cast<unsigned>(std::min<std::size_t>(resolveThreadCount(nThreads), std::max<std::size_t>(nChunks, 1U)));
+            std::vector<CircuitMetrics> partial(threads);
+            parallelForWorkStealing(nChunks, threads, [&](const unsigned thread, const std::size_t chunk) {
+                const auto begin = std::next(first, static_cast<std::ptrdiff_t>(chunk * chunkSize));
+                const auto end   = std::next(begin, static_cast<std::ptrdiff_t>(std::min(chunkSize, nGates - (chunk * chunkSize))));
+                for (auto it = begin; it != end; ++it) {
+                    partial[thread].add(**it);
+                }
+            });
+
+            CircuitMetrics metrics;
+            for (const auto& p: partial) {
+                metrics.merge(p);
+            }
+            return metrics;
+        }
+
+    private:
+        static constexpr std::size_t NTYPES = 3U;
+
+        // number of gates indexed by number of controls and type
+        std::vector<std::array<std::size_t, NTYPES>> counts;
+    };
+
+} // namespace syrec
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "core/utils/small_set.hpp"
+
 #include <algorithm>
 #include <any>
+#include <array>
+#include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
-#include <set>
-#include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace syrec {
@@ -27,8 +33,10 @@ namespace syrec {
 
         /**
         * @brief Container for storing lines
+        *
+        * Ordered set of lines, most gates have at most three controls which are stored inline.
         */
-        using line_container = std::set<line>;
+        using line_container = SmallSet<line, 3U>;
 
         /**
         * @brief Default constructor
@@ -39,10 +47,17 @@ namespace syrec {
         using cost_t = std::uint_least64_t;
 
         [[nodiscard]] cost_t quantumCost(unsigned lines) const {
+            return quantumCost(type, controls.size(), lines);
+        }
+
+        /**
+        * @brief Returns the quantum cost of a gate of type \p type with \p nControls controls in a circuit with \p lines lines
+        */
+        [[nodiscard]] static cost_t quantumCost(const Types type, const std::size_t nControls, unsigned lines) {
             cost_t costs = 0U;
 
             unsigned    n = lines;
-            std::size_t c = controls.size();
+            std::size_t c = nControls;
 
             if (type == Gate::Types::Fredkin) {
                 c += 1U;
@@ -119,14 +134,24 @@ namespace syrec {
          * @return QASM string
          */
         [[nodiscard]] std::string toQasm() const {
-            std::stringstream ss;
-            ss << std::string(controls.size(), 'c');
+            std::string qasm;
+            appendQasm(qasm);
+            return qasm;
+        }
+
+        /**
+         * @brief Appends the QASM representation of the gate to \p out
+         *
+         * Same as toQasm(), but formats into an existing string such that its storage can be reused.
+         */
+        void appendQasm(std::string& out) const {
+            out.append(controls.size(), 'c');
             switch (type) {
                 case Types::Fredkin:
-                    ss << "swap";
+                    out += "swap";
                     break;
                 case Types::Toffoli:
-                    ss << "x";
+                    out += "x";
                     break;
                 // GCOVR_EXCL_START
                 default:
@@ -134,14 +159,26 @@ namespace syrec {
                     // GCOVR_EXCL_STOP
             }
             for (const auto& control: controls) {
-                ss << " q[" << control << "],";
+                out += " q[";
+                appendLine(out, control);
+                out += "],";
             }
-            if (type == Types::Toffoli) {
-                ss << " q[" << *targets.begin() << "];";
-            } else {
-                ss << " q[" << *targets.begin() << "], q[" << *std::next(targets.begin()) << "];";
+            out += " q[";
+            appendLine(out, *targets.begin());
+            if (type == Types::Fredkin) {
+                out += "], q[";
+                appendLine(out, *std::next(targets.begin()));
             }
-            return ss.str();
+            out += "];";
+        }
+
+        /**
+         * @brief Appends the decimal representation of line \p l to \p out
+         */
+        static void appendLine(std::string& out, const line l) {
+            std::array<char, 24> digits{};
+            const auto           result = std::to_chars(digits.data(), digits.data() + digits.size(), l);
+            out.append(digits.data(), result.ptr);
         }
 
         line_container controls{};
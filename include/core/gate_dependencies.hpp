@@ -0,0 +1,222 @@
+#pragma once
+
+#include "core/gate.hpp"
+#include "core/utils/cache_mutex.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Line occupancy and dependencies of a sequence of gates
+    *
+    * Gates are identified by their position, i.e., the number of gates added before them. For
+    * every line, the index keeps the positions of the gates acting on it in ascending order. A gate
+    * depends on the preceding gate of each of its lines, which yields a DAG whose edges only point
+    * from earlier to later positions.
+    *
+    * The ASAP layer of a gate is the length of the longest path of dependencies ending in it, the
+    * ALAP layer is the latest layer it can be moved to without increasing the depth. Both are
+    * counted from 0. Gates are added in one linear pass, and ASAP layers are maintained while
+    * adding. ALAP layers depend on all later gates and are computed by a single backward pass
+    * on first access. The computation is guarded by a mutex, so the const functions can be called
+    * from several threads at once.
+    */
+    class GateDependencies {
+    public:
+        using position = std::size_t;
+
+        /**
+        * @brief Contiguous range of gate positions in ascending order
+        */
+        class Positions {
+        public:
+            Positions(const position* first, const position* last):
+                first(first), last(last) {}
+
+            [[nodiscard]] const position* begin() const {
+                return first;
+            }
+
+            [[nodiscard]] const position* end() const {
+                return last;
+            }
+
+            [[nodiscard]] std::size_t size() const {
+                return static_cast<std::size_t>(last - first);
+            }
+
+            [[nodiscard]] bool empty() const {
+                return first == last;
+            }
+
+        private:
+            const position* first;
+            const position* last;
+        };
+
+        GateDependencies() {
+            lineOffsets.emplace_back(0U);
+            predecessorOffsets.emplace_back(0U);
+        }
+
+        /**
+        * @brief Adds \p g behind all gates added before
+        */
+        void add(const Gate& g) {
+            const auto  pos              = numGates();
+            const auto  firstPredecessor = predecessors.size();
+            std::size_t layer            = 0U;
+            for (const auto* lines: {&g.controls, &g.targets}) {
+                for (const auto l: *lines) {
+                    if (l >= lineGates.size()) {
+                        lineGates.resize(l + 1U);
+                    }
+                    auto& onLine = lineGates[l];
+                    if (!onLine.empty()) {
+                        const auto p = onLine.back();
+                        if (std::find(predecessors.cbegin() + static_cast<std::ptrdiff_t>(firstPredecessor), predecessors.cend(), p) == predecessors.cend()) {
+                            predecessors.emplace_back(p);
+                            layer = std::max(layer, asapLayers[p] + 1U);
+                        }
+                    }
+                    onLine.emplace_back(pos);
+                    gateLines.emplace_back(l);
+                }
+            }
+            std::sort(predecessors.begin() + static_cast<std::ptrdiff_t>(firstPredecessor), predecessors.end());
+            predecessorOffsets.emplace_back(predecessors.size());
+            lineOffsets.emplace_back(gateLines.size());
+            asapLayers.emplace_back(layer);
+            if (lineOffsets[pos] != gateLines.size()) {
+                maxDepth = std::max(maxDepth, layer + 1U);
+            }
+            alapLayers.clear();
+        }
+
+        /**
+        * @brief Removes all gates
+        */
+        void clear() {
+            *this = GateDependencies();
+        }
+
+        /**
+        * @brief Returns the number of gates
+        */
+        [[nodiscard]] std::size_t numGates() const {
+            return asapLayers.size();
+        }
+
+        /**
+        * @brief Returns the positions of the gates acting on line \p l
+        */
+        [[nodiscard]] Positions gatesOn(const Gate::line l) const {
+            if (l >= lineGates.size()) {
+                return {nullptr, nullptr};
+            }
+            return {lineGates[l].data(), lineGates[l].data() + lineGates[l].size()};
+        }
+
+        /**
+        * @brief Returns the positions of the gates the gate at \p pos directly depends on
+        */
+        [[nodiscard]] Positions predecessorsOf(const position pos) const {
+            return {predecessors.data() + predecessorOffsets[pos], predecessors.data() + predecessorOffsets[pos + 1U]};
+        }
+
+        /**
+        * @brief Returns the positions of the gates directly depending on the gate at \p pos, in ascending order
+        */
+        [[nodiscard]] std::vector<position> successorsOf(const position pos) const {
+            std::vector<position> successors;
+            for (auto i = lineOffsets[pos]; i < lineOffsets[pos + 1U]; ++i) {
+                const auto& onLine = lineGates[gateLines[i]];
+                const auto  next   = std::upper_bound(onLine.cbegin(), onLine.cend(), pos);
+                if (next != onLine.cend()) {
+                    successors.emplace_back(*next);
+                }
+            }
+            std::sort(successors.begin(), successors.end());
+            successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+            return successors;
+        }
+
+        /**
+        * @brief Returns the earliest layer of the gate at \p pos
+        */
+        [[nodiscard]] std::size_t asap(const position pos) const {
+            return asapLayers[pos];
+        }
+
+        /**
+        * @brief Returns the latest layer of the gate at \p pos that does not increase the depth
+        */
+        [[nodiscard]] std::size_t alap(const position pos) const {
+            const std::lock_guard<CacheMutex> lock(alapMutex);
+            if (alapLayers.size() != numGates()) {
+                computeAlapLayers();
+            }
+            return alapLayers[pos];
+        }
+
+        /**
+        * @brief Returns the number of layers
+        */
+        [[nodiscard]] std::size_t depth() const {
+            return maxDepth;
+        }
+
+        /**
+        * @brief Builds the index of the gates <tt>[first, last)</tt> in one pass
+        *
+        * @param first Iterator to the first gate, dereferencing to a pointer to a gate
+        * @param last Iterator behind the last gate
+        */
+        template<typename GateIt>
+        [[nodiscard]] static GateDependencies build(const GateIt first, const GateIt last) {
+            GateDependencies dependencies;
+            for (auto it = first; it != last; ++it) {
+                dependencies.add(**it);
+            }
+            return dependencies;
+        }
+
+    private:
+        // the number of layers from a gate to the end, counting itself, determines its latest layer
+        void computeAlapLayers() const {
+            std::vector<std::size_t> next(lineGates.size(), 0U);
+            alapLayers.assign(numGates(), 0U);
+            for (auto pos = numGates(); pos-- > 0U;) {
+                std::size_t height = 0U;
+                for (auto i = lineOffsets[pos]; i < lineOffsets[pos + 1U]; ++i) {
+                    height = std::max(height, next[gateLines[i]]);
+                }
+                ++height;
+                for (auto i = lineOffsets[pos]; i < lineOffsets[pos + 1U]; ++i) {
+                    next[gateLines[i]] = height;
+                }
+                alapLayers[pos] = maxDepth >= height ? maxDepth - height : 0U;
+            }
+        }
+
+        // gates acting on every line
+        std::vector<std::vector<position>> lineGates;
+        // lines of every gate, those of gate i are [lineOffsets[i], lineOffsets[i + 1])
+        std::vector<Gate::line>  gateLines;
+        std::vector<std::size_t> lineOffsets;
+        // direct predecessors of every gate, stored the same way
+        std::vector<position>    predecessors;
+        std::vector<std::size_t> predecessorOffsets;
+
+        std::vector<std::size_t>         asapLayers;
+        mutable std::vector<std::size_t> alapLayers;
+        mutable CacheMutex               alapMutex;
+        std::size_t                      maxDepth = 0U;
+    };
+
+} // namespace syrec
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace syrec {
+
+    /**
+     * @brief Writes the circuit in the binary circuit format
+     *
+     * The format stores the lines with their names, constants, and garbage flags, followed by one fixed-size
+     * record per gate and a single array holding the control and target lines of all gates. Annotations are
+     * stored at the end if requested. All numbers are stored in the byte order of the writing machine,
+     * which is recorded in the header and checked when reading.
+     *
+     * @param os Stream to write to, must be opened in binary mode
+     * @param circ Circuit to be written
+     * @param annotations If true, the annotations of the gates are written as well
+     *
+     * @throws std::invalid_argument If a gate cannot be read back, i.e., it is neither a Toffoli gate with one target nor
+     *         a Fredkin gate with two targets, or it acts on a line beyond the lines of \p circ. Nothing is written then.
+     */
+    void writeBinary(std::ostream& os, const Circuit& circ, bool annotations = true);
+
+    /**
+     * @brief Write circuit to a binary circuit file, see writeBinary
+     * @param circ Circuit to be written
+     * @param filename Filename
+     * @param annotations If true, the annotations of the gates are written as well
+     * @return True if successful, false otherwise
+     *
+     * @throws std::invalid_argument Same as writeBinary, the file is not created then
+     */
+    [[nodiscard]] bool toBinaryFile(const Circuit& circ, const std::string& filename, bool annotations = true);
+
+    /**
+     * @brief Read-only view of a binary circuit file
+     *
+     * The file is memory-mapped, and its gates are accessed in place without copying or allocating anything
+     * per gate. Opening the file validates its structure once, such that all accessors can rely on it.
+     * The view must outlive all gate views obtained from it.
+     */
+    class MappedCircuit {
+    public:
+        /**
+         * @brief Range of lines of a gate, stored in ascending order
+         */
+        class LineRange {
+        public:
+            LineRange(const std::uint32_t* first, const std::uint32_t* last):
+                first(first), last(last) {}
+
+            [[nodiscard]] const std::uint32_t* begin() const {
+                return first;
+            }
+
+            [[nodiscard]] const std::uint32_t* end() const {
+                return last;
+            }
+
+            [[nodiscard]] std::size_t size() const {
+                return static_cast<std::size_t>(last - first);
+            }
+
+            [[nodiscard]] bool empty() const {
+                return first == last;
+            }
+
+        private:
+            const std::uint32_t* first;
+            const std::uint32_t* last;
+        };
+
+        /**
+         * @brief Gate of a mapped circuit
+         */
+        class GateView {
+        public:
+            GateView(const Gate::Types type, const LineRange controls, const LineRange targets):
+                gateType(type), controlLines(controls), targetLines(targets) {}
+
+            [[nodiscard]] Gate::Types type() const {
+                return gateType;
+            }
+
+            [[nodiscard]] const LineRange& controls() const {
+                return controlLines;
+            }
+
+            [[nodiscard]] const LineRange& targets() const {
+                return targetLines;
+            }
+
+        private:
+            Gate::Types gateType;
+            LineRange   controlLines;
+            LineRange   targetLines;
+        };
+
+        /**
+         * @brief Maps and validates a binary circuit file
+         *
+         * @param filename File written by writeBinary
+         *
+         * @throws std::runtime_error If the file cannot be mapped or is not a valid binary circuit file
+         */
+        explicit MappedCircuit(const std::string& filename);
+
+        [[nodiscard]] unsigned getLines() const {
+            return lines;
+        }
+
+        [[nodiscard]] std::size_t numGates() const {
+            return nGates;
+        }
+
+        [[nodiscard]] const std::vector<std::string>& getInputs() const {
+            return inputs;
+        }
+
+        [[nodiscard]] const std::vector<std::string>& getOutputs() const {
+            return outputs;
+        }
+
+        [[nodiscard]] const std::vector<constant>& getConstants() const {
+            return constants;
+        }
+
+        [[nodiscard]] const std::vector<bool>& getGarbage() const {
+            return garbage;
+        }
+
+        /**
+         * @brief Returns whether the file contains annotations
+         */
+        [[nodiscard]] bool hasAnnotations() const {
+            return annotationsOffset != 0U;
+        }
+
+        /**
+         * @brief Returns the gate with index \p i
+         */
+        [[nodiscard]] GateView gate(std::size_t i) const;
+
+        /**
+         * @brief Copies the circuit into \p circ
+         *
+         * Sets the lines and their meta-data of \p circ and appends all gates together with their annotations.
+         * The gateAdded hook of \p circ is not invoked. If an annotation is corrupt, \p circ is left unchanged.
+         *
+         * @param circ Circuit without gates
+         *
+         * @throws std::invalid_argument If \p circ already has gates
+         * @throws std::runtime_error If an annotation of the file is corrupt
+         */
+        void load(Circuit& circ) const;
+
+    private:
+        [[nodiscard]] const std::byte* data() const {
+            return static_cast<const std::byte*>(region.get_address());
+        }
+
+        boost::interprocess::file_mapping  file;
+        boost::interprocess::mapped_region region;
+
+        unsigned                 lines{};
+        std::size_t              nGates{};
+        std::vector<std::string> inputs;
+        std::vector<std::string> outputs;
+        std::vector<constant>    constants;
+        std::vector<bool>        garbage;
+
+        // byte offsets of the sections, the annotations offset is 0 if there are none
+        std::size_t          gatesOffset{};
+        const std::uint32_t* indices{};
+        std::size_t          annotationsOffset{};
+    };
+
+} // namespace syrec
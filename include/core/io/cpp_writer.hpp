@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/circuit.hpp"
+
+#include <ostream>
+#include <string>
+
+namespace syrec {
+
+    /**
+     * @brief Writes a self-contained C++ header that emulates the circuit
+     *
+     * The header defines
+     * - <tt>inline constexpr std::size_t <functionName>_lines</tt>, the number of lines, and
+     * - <tt>inline void <functionName>(std::uint64_t* lines)</tt>, which applies the circuit in place.
+     *
+     * The function works on bit-sliced patterns: <tt>lines[l]</tt> holds the value of line \em l for 64
+     * independent patterns, bit \em k of every word belonging to pattern \em k. All gates are unrolled into
+     * straight-line word operations on local variables, so the compiler can keep the lines in registers.
+     * Constant lines are not initialized by the function, the caller has to set them like any other input.
+     *
+     * The header only depends on the standard library and can be compiled into other projects as is.
+     *
+     * @param os Stream to write to
+     * @param circ Circuit to be emitted
+     * @param functionName Name of the generated function, must be a valid C++ identifier
+     */
+    void writeCpp(std::ostream& os, const Circuit& circ, const std::string& functionName);
+
+    /**
+     * @brief Convert circuit to a C++ header, see writeCpp
+     * @param circ Circuit to be emitted
+     * @param functionName Name of the generated function, must be a valid C++ identifier
+     * @return C++ source string
+     */
+    [[nodiscard]] std::string toCpp(const Circuit& circ, const std::string& functionName = "simulate");
+
+    /**
+     * @brief Write circuit to a C++ header file, see writeCpp
+     * @param circ Circuit to be emitted
+     * @param filename Filename (should end with .hpp)
+     * @param functionName Name of the generated function, must be a valid C++ identifier
+     * @return True if successful, false otherwise
+     */
+    [[nodiscard]] bool toCppFile(const Circuit& circ, const std::string& filename, const std::string& functionName = "simulate");
+
+} // namespace syrec
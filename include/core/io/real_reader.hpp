@@ -0,0 +1,37 @@
+#pragma once
+
+#include "core/circuit.hpp"
+
+#include <istream>
+#include <string>
+
+namespace syrec {
+
+    /**
+     * @brief Reads a circuit in the RevLib .real format
+     *
+     * Supports the <tt>.numvars</tt>, <tt>.variables</tt>, <tt>.inputs</tt>, <tt>.outputs</tt>, <tt>.constants</tt>,
+     * and <tt>.garbage</tt> headers, and multiple-controlled Toffoli (<tt>t</tt>) and Fredkin (<tt>f</tt>) gates with
+     * positive controls. Names may be enclosed in quotes. Comments and other headers, such as <tt>.version</tt> or
+     * <tt>.inputbus</tt>, are skipped. Lines of \p circ which are not declared by the headers get the defaults of
+     * Circuit::setLines, the input and output names default to the variable names.
+     *
+     * The file is read line by line without materializing it, which is also fast for large RevLib benchmarks.
+     *
+     * @param circ Circuit without gates
+     * @param is Stream to read from
+     *
+     * @throws std::runtime_error If the input is not a valid .real file or contains unsupported gates,
+     * the message contains the line number
+     */
+    void parseReal(Circuit& circ, std::istream& is);
+
+    /**
+     * @brief Reads a circuit from a RevLib .real file, see parseReal
+     * @param circ Circuit without gates
+     * @param filename Filename
+     * @return False if the file cannot be opened, true otherwise
+     */
+    bool readReal(Circuit& circ, const std::string& filename);
+
+} // namespace syrec
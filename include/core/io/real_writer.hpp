@@ -0,0 +1,44 @@
+#pragma once
+
+#include "core/circuit.hpp"
+
+#include <ostream>
+#include <string>
+
+namespace syrec {
+
+    /**
+     * @brief Writes the circuit in the RevLib .real format
+     *
+     * Line \em l is declared as variable <tt>x<l></tt>. The input and output names of the circuit are written
+     * to the <tt>.inputs</tt> and <tt>.outputs</tt> headers, enclosed in quotes if they contain characters
+     * other than letters, digits, and underscores. Constant and garbage lines are written to the
+     * <tt>.constants</tt> and <tt>.garbage</tt> headers.
+     *
+     * The gates are formatted through a reusable buffer, so the representation of the whole circuit is
+     * never held in memory.
+     *
+     * @param os Stream to write to
+     * @param circ Circuit to be written
+     * @param nThreads Number of threads formatting chunks of gates concurrently, the output does not depend on it.
+     * 0 selects the number of available cores. Circuits with instances are formatted on the calling thread.
+     */
+    void writeReal(std::ostream& os, const Circuit& circ, unsigned nThreads = 1U);
+
+    /**
+     * @brief Convert circuit to a RevLib .real string, see writeReal
+     * @param circ Circuit to be written
+     * @return .real string
+     */
+    [[nodiscard]] std::string toReal(const Circuit& circ);
+
+    /**
+     * @brief Write circuit to a RevLib .real file, see writeReal
+     * @param circ Circuit to be written
+     * @param filename Filename (should end with .real)
+     * @param nThreads Number of threads formatting chunks of gates concurrently
+     * @return True if successful, false otherwise
+     */
+    [[nodiscard]] bool toRealFile(const Circuit& circ, const std::string& filename, unsigned nThreads = 1U);
+
+} // namespace syrec
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Append-only store of objects in chunks
+    *
+    * Objects are constructed in place in chunks, so adding an object only allocates once per
+    * chunk and never moves the objects created before. Chunks start small and double in size
+    * up to \p ChunkSize slots, such that arenas holding few objects stay small. References
+    * and pointers to the objects stay valid until the arena is destroyed, also when the
+    * arena itself is moved or spliced into another arena.
+    *
+    * Every object has an index, which is the number of objects added before it. Indices are
+    * stable as well, splicing an arena shifts the indices of its objects by the size of the
+    * receiving arena.
+    */
+    template<typename T, std::size_t ChunkSize = 256U>
+    class Arena {
+    public:
+        Arena() = default;
+
+        Arena(const Arena&)            = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        Arena(Arena&& other) noexcept:
+            chunks(std::exchange(other.chunks, {})), chunkByAddress(std::exchange(other.chunkByAddress, {})), count(std::exchange(other.count, 0U)) {}
+
+        Arena& operator=(Arena&& other) noexcept {
+            if (this != &other) {
+                clear();
+                chunks         = std::exchange(other.chunks, {});
+                chunkByAddress = std::exchange(other.chunkByAddress, {});
+                count          = std::exchange(other.count, 0U);
+            }
+            return *this;
+        }
+
+        ~Arena() {
+            clear();
+        }
+
+        /**
+        * @brief Constructs a new object at the end of the arena
+        *
+        * The new object has the index size() - 1.
+        *
+        * @return Reference to the new object, which is valid for the lifetime of the arena
+        */
+        template<typename... Args>
+        T& emplace(Args&&... args) {
+            if (chunks.empty() || chunks.back().size == chunks.back().capacity) {
+                const std::size_t capacity = chunks.empty() ? MinChunkSize : std::min(2U * chunks.back().capacity, ChunkSize);
+                chunks.emplace_back(Chunk{std::make_unique<Slot[]>(capacity), 0U, capacity, count}); // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+                chunkByAddress.emplace(chunks.back().slots.get(), chunks.size() - 1U);
+            }
+            auto& chunk = chunks.back();
+            T*    obj   = ::new (static_cast<void*>(chunk.slots[chunk.size].data.data())) T(std::forward<Args>(args)...);
+            ++chunk.size;
+            ++count;
+            return *obj;
+        }
+
+        /**
+        * @brief Takes over all objects of \p other without moving them
+        *
+        * Only the chunks change hands, so this takes time linear in the number of chunks of \p other.
+        * The objects stay at their addresses and are destroyed with this arena, \p other is left empty.
+        * The object with index \em i in \p other has index <em>size() + i</em> afterwards, where size()
+        * is taken before the call.
+        */
+        void splice(Arena&& other) {
+            if (this == &other) {
+                return;
+            }
+            for (auto& chunk: other.chunks) {
+                chunk.base += count;
+                chunks.emplace_back(std::move(chunk));
+                chunkByAddress.emplace(chunks.back().slots.get(), chunks.size() - 1U);
+            }
+            count += other.count;
+            other.chunks.clear();
+            other.chunkByAddress.clear();
+            other.count = 0U;
+        }
+
+        /**
+        * @brief Returns the index of \p obj, or an empty optional if \p obj is not an object of this arena
+        */
+        [[nodiscard]] std::optional<std::size_t> indexOf(const T& obj) const {
+            if (chunks.empty()) {
+                return std::nullopt;
+            }
+            // objects are usually looked up right after they have been added
+            if (const auto index = indexIn(chunks.back(), obj)) {
+                return chunks.back().base + *index;
+            }
+            auto it = chunkByAddress.upper_bound(static_cast<const void*>(&obj));
+            if (it == chunkByAddress.begin()) {
+                return std::nullopt;
+            }
+            --it;
+            const auto& chunk = chunks[it->second];
+            if (const auto index = indexIn(chunk, obj)) {
+                return chunk.base + *index;
+            }
+            return std::nullopt;
+        }
+
+        /**
+        * @brief Returns the number of objects in the arena
+        */
+        [[nodiscard]] std::size_t size() const {
+            return count;
+        }
+
+        /**
+        * @brief Destroys all objects and releases the chunks
+        */
+        void clear() {
+            for (auto& chunk: chunks) {
+                for (std::size_t i = 0U; i < chunk.size; ++i) {
+                    std::launder(reinterpret_cast<T*>(chunk.slots[i].data.data()))->~T();
+                }
+            }
+            chunks.clear();
+            chunkByAddress.clear();
+            count = 0U;
+        }
+
+    private:
+        struct alignas(T) Slot {
+            std::array<std::byte, sizeof(T)> data;
+        };
+
+        struct Chunk {
+            std::unique_ptr<Slot[]> slots; // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+            // number of constructed objects, only the last chunk is filled up further
+            std::size_t size;
+            std::size_t capacity;
+            // index of the first object of the chunk
+            std::size_t base;
+        };
+
+        static constexpr std::size_t MinChunkSize = ChunkSize < 4U ? ChunkSize : 4U;
+
+        // slot of obj in chunk, empty if obj is not a constructed object of chunk
+        static std::optional<std::size_t> indexIn(const Chunk& chunk, const T& obj) {
+            const auto* first = static_cast<const void*>(chunk.slots.get());
+            const auto* last  = static_cast<const void*>(chunk.slots.get() + chunk.size);
+            const auto* p     = static_cast<const void*>(&obj);
+            if (std::less<const void*>{}(p, first) || !std::less<const void*>{}(p, last)) {
+                return std::nullopt;
+            }
+            const auto offset = static_cast<std::size_t>(reinterpret_cast<const std::byte*>(p) - reinterpret_cast<const std::byte*>(first));
+            if (offset % sizeof(Slot) != 0U) {
+                return std::nullopt;
+            }
+            return offset / sizeof(Slot);
+        }
+
+        std::vector<Chunk>                  chunks;
+        std::map<const void*, std::size_t>  chunkByAddress;
+        std::size_t                         count = 0U;
+    };
+
+} // namespace syrec
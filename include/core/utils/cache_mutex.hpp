@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mutex>
+
+namespace syrec {
+
+    /**
+    * @brief Mutex guarding a cache that const member functions fill on access
+    *
+    * Copying or moving yields a new unlocked mutex, so classes holding one keep their implicit
+    * copy and move operations, the cached data is copied by the owning class as usual. Meets
+    * the <em>Lockable</em> requirements, e.g., for <tt>std::lock_guard</tt>.
+    */
+    class CacheMutex {
+    public:
+        CacheMutex()  = default;
+        ~CacheMutex() = default;
+
+        CacheMutex(const CacheMutex& /*other*/) noexcept {}
+
+        CacheMutex& operator=(const CacheMutex& /*other*/) noexcept {
+            return *this;
+        }
+
+        void lock() {
+            mutex.lock();
+        }
+
+        [[nodiscard]] bool try_lock() {
+            return mutex.try_lock();
+        }
+
+        void unlock() {
+            mutex.unlock();
+        }
+
+    private:
+        std::mutex mutex;
+    };
+
+} // namespace syrec
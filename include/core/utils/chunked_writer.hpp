@@ -0,0 +1,76 @@
+#pragma once
+
+#include "core/utils/work_stealing.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Formats a range of elements into a stream through reusable buffers
+    *
+    * Every element is appended to a text buffer by <tt>format(buffer, element)</tt>. The buffer is
+    * written to \p os whenever it exceeds a few kilobytes and then reused, so the text of the whole
+    * range is never materialized at once.
+    *
+    * With more than one thread, the range is split into chunks which are formatted concurrently into
+    * one buffer per thread, one wave of \p nThreads chunks at a time, and written in range order.
+    * The output is identical to the sequential one as long as \p format only depends on its element.
+    *
+    * @param os       Stream to write to
+    * @param first    Iterator to the first element
+    * @param last     Iterator behind the last element
+    * @param nThreads Number of threads. 0 selects the number of available cores.
+    * @param format   Appends the text of an element to a string, called concurrently from different threads
+    *
+    * @throws Rethrows an exception of \p format on the calling thread, after all threads have been joined.
+    *         Nothing of the wave of chunks in which it occurred has been written then.
+    */
+    template<typename It, typename Format>
+    void writeChunked(std::ostream& os, const It first, const It last, const unsigned nThreads, const Format& format) {
+        constexpr std::size_t flushSize = 1U << 16U;
+        constexpr std::size_t chunkSize = 1U << 14U;
+
+        const auto nElements = static_cast<std::size_t>(std::distance(first, last));
+        const auto nChunks   = (nElements + chunkSize - 1U) / chunkSize;
+        const auto threads   = static_cast<unsigned>(std::min<std::size_t>(resolveThreadCount(nThreads), nChunks));
+
+        if (threads <= 1U) {
+            std::string buffer;
+            buffer.reserve(flushSize + 256U);
+            for (auto it = first; it != last; ++it) {
+                format(buffer, *it);
+                if (buffer.size() >= flushSize) {
+                    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            }
+            os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            return;
+        }
+
+        std::vector<std::string> buffers(threads);
+        for (std::size_t wave = 0U; wave < nChunks; wave += threads) {
+            const auto nWaveChunks = std::min<std::size_t>(threads, nChunks - wave);
+            parallelForWorkStealing(nWaveChunks, threads, [&](const unsigned /*thread*/, const std::size_t i) {
+                const auto chunk = wave + i;
+                const auto begin = std::next(first, static_cast<std::ptrdiff_t>(chunk * chunkSize));
+                const auto end   = std::next(begin, static_cast<std::ptrdiff_t>(std::min(chunkSize, nElements - (chunk * chunkSize))));
+                auto&      buffer = buffers[i];
+                buffer.clear();
+                for (auto it = begin; it != end; ++it) {
+                    format(buffer, *it);
+                }
+            });
+            for (std::size_t i = 0U; i < nWaveChunks; ++i) {
+                os.write(buffers[i].data(), static_cast<std::streamsize>(buffers[i].size()));
+            }
+        }
+    }
+
+} // namespace syrec
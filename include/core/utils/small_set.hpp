@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace syrec {
+
+    /**
+    * @brief Ordered set stored as a sorted array with inline storage for small sizes
+    *
+    * Up to \p N values are stored inside the object itself, larger sets move to a heap array.
+    * The interface follows the parts of <tt>std::set</tt> used for gate lines: values are
+    * unique and iterated in ascending order, and iterators are plain pointers that are
+    * invalidated by any modification.
+    */
+    template<typename T, std::size_t N>
+    class SmallSet {
+        static_assert(std::is_trivially_copyable_v<T>, "SmallSet only supports trivially copyable values");
+        static_assert(N > 0U, "SmallSet needs inline storage for at least one value");
+
+    public:
+        using value_type     = T;
+        using size_type      = std::size_t;
+        using const_iterator = const T*;
+        using iterator       = const_iterator;
+
+        SmallSet() = default;
+
+        SmallSet(std::initializer_list<T> values) {
+            insert(values);
+        }
+
+        template<typename InputIt>
+        SmallSet(InputIt first, InputIt last) {
+            insert(first, last);
+        }
+
+        SmallSet(const SmallSet& other) {
+            *this = other;
+        }
+
+        SmallSet(SmallSet&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        SmallSet& operator=(const SmallSet& other) {
+            if (this != &other) {
+                reserve(other.nValues);
+                std::copy(other.begin(), other.end(), values());
+                nValues = other.nValues;
+            }
+            return *this;
+        }
+
+        SmallSet& operator=(SmallSet&& other) noexcept {
+            if (this != &other) {
+                if (other.isInline()) {
+                    std::copy(other.begin(), other.end(), values());
+                } else {
+                    release();
+                    heap      = std::exchange(other.heap, nullptr);
+                    capacity  = std::exchange(other.capacity, static_cast<std::uint32_t>(N));
+                    other.buf = {};
+                }
+                nValues = std::exchange(other.nValues, 0U);
+            }
+            return *this;
+        }
+
+        ~SmallSet() {
+            release();
+        }
+
+        [[nodiscard]] const_iterator begin() const {
+            return values();
+        }
+
+        [[nodiscard]] const_iterator end() const {
+            return values() + nValues;
+        }
+
+        [[nodiscard]] const_iterator cbegin() const {
+            return begin();
+        }
+
+        [[nodiscard]] const_iterator cend() const {
+            return end();
+        }
+
+        [[nodiscard]] size_type size() const {
+            return nValues;
+        }
+
+        [[nodiscard]] bool empty() const {
+            return nValues == 0U;
+        }
+
+        /**
+        * @brief Inserts \p value if it is not in the set yet
+        *
+        * @return Iterator to the value in the set and whether it has been inserted
+        */
+        std::pair<iterator, bool> insert(const T& value) {
+            auto* pos = std::lower_bound(values(), values() + nValues, value);
+            if (pos != values() + nValues && *pos == value) {
+                return {pos, false};
+            }
+            const auto index = pos - values();
+            reserve(nValues + 1U);
+            auto* first = values();
+            std::copy_backward(first + index, first + nValues, first + nValues + 1U);
+            first[index] = value;
+            ++nValues;
+            return {first + index, true};
+        }
+
+        template<typename InputIt>
+        void insert(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                insert(static_cast<T>(*first));
+            }
+        }
+
+        void insert(std::initializer_list<T> values) {
+            insert(values.begin(), values.end());
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return insert(T(std::forward<Args>(args)...));
+        }
+
+        /**
+        * @brief Removes \p value from the set
+        *
+        * @return Number of removed values
+        */
+        size_type erase(const T& value) {
+            auto* last = values() + nValues;
+            auto* pos  = std::lower_bound(values(), last, value);
+            if (pos == last || *pos != value) {
+                return 0U;
+            }
+            std::copy(pos + 1, last, pos);
+            --nValues;
+            return 1U;
+        }
+
+        void clear() {
+            nValues = 0U;
+        }
+
+        [[nodiscard]] const_iterator find(const T& value) const {
+            const auto* pos = std::lower_bound(begin(), end(), value);
+            return pos != end() && *pos == value ? pos : end();
+        }
+
+        [[nodiscard]] size_type count(const T& value) const {
+            return find(value) != end() ? 1U : 0U;
+        }
+
+        friend bool operator==(const SmallSet& lhs, const SmallSet& rhs) {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator!=(const SmallSet& lhs, const SmallSet& rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const SmallSet& lhs, const SmallSet& rhs) {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    private:
+        [[nodiscard]] bool isInline() const {
+            return capacity == N;
+        }
+
+        [[nodiscard]] T* values() {
+            return isInline() ? buf.data() : heap;
+        }
+
+        [[nodiscard]] const T* values() const {
+            return isInline() ? buf.data() : heap;
+        }
+
+        // grows the storage geometrically such that it holds at least n values
+        void reserve(const std::size_t n) {
+            if (n <= capacity) {
+                return;
+            }
+            const auto newCapacity = static_cast<std::uint32_t>(std::max<std::size_t>(n, 2U * capacity));
+            auto*      newValues   = new T[newCapacity]; // NOLINT(cppcoreguidelines-owning-memory)
+            std::copy(values(), values() + nValues, newValues);
+            release();
+            heap     = newValues;
+            capacity = newCapacity;
+        }
+
+        void release() {
+            if (!isInline()) {
+                delete[] heap; // NOLINT(cppcoreguidelines-owning-memory)
+                buf      = {};
+                capacity = static_cast<std::uint32_t>(N);
+            }
+        }
+
+        std::uint32_t nValues  = 0U;
+        std::uint32_t capacity = static_cast<std::uint32_t>(N);
+        union {
+            std::array<T, N> buf{};
+            T*               heap;
+        };
+    };
+
+} // namespace syrec
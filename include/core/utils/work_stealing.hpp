@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace syrec {
+
+    /**
+    * @brief Resolves a requested number of threads
+    *
+    * @param requested Requested number of threads. 0 selects the number of available cores.
+    * @return The number of threads to use, at least 1
+    */
+    inline unsigned resolveThreadCount(const unsigned requested) {
+        if (requested != 0U) {
+            return requested;
+        }
+        return std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    /**
+    * @brief Runs a task for all chunks of a work range on a work-stealing thread pool
+    *
+    * The chunks <tt>[0, nChunks)</tt> are initially distributed as contiguous ranges over
+    * \p nThreads threads. Every thread processes its own range front to back. A thread
+    * that runs out of work steals the upper half of the remaining range of another thread,
+    * so unevenly expensive chunks still keep all threads busy.
+    *
+    * The task is called as <tt>task(threadIndex, chunk)</tt>, concurrently from different threads.
+    * The thread index lies in <tt>[0, nThreads)</tt> and can be used to address per-thread scratch data.
+    *
+    * If the task throws, the threads stop taking further chunks, and after all threads have been
+    * joined the exception of the lowest thread index is rethrown on the calling thread.
+    *
+    * @param nChunks  Number of chunks
+    * @param nThreads Number of threads. If 1, all chunks are processed by the calling thread.
+    * @param task     Task to be run for each chunk
+    */
+    template<typename Task>
+    void parallelForWorkStealing(const std::size_t nChunks, unsigned nThreads, const Task& task) {
+        nThreads = static_cast<unsigned>(std::max<std::size_t>(1U, std::min<std::size_t>(nThreads, nChunks)));
+        if (nThreads == 1U) {
+            for (std::size_t chunk = 0U; chunk < nChunks; ++chunk) {
+                task(0U, chunk);
+            }
+            return;
+        }
+
+        struct Range {
+            std::mutex  mutex;
+            std::size_t begin{};
+            std::size_t end{};
+        };
+        std::vector<Range> ranges(nThreads);
+        for (unsigned i = 0U; i < nThreads; ++i) {
+            ranges[i].begin = nChunks * i / nThreads;
+            ranges[i].end   = nChunks * (i + 1U) / nThreads;
+        }
+
+        const auto steal = [&ranges, nThreads](const unsigned thief) {
+            for (unsigned offset = 1U; offset < nThreads; ++offset) {
+                std::size_t begin{};
+                std::size_t end{};
+                {
+                    auto&                 victim = ranges[(thief + offset) % nThreads];
+                    const std::lock_guard lock(victim.mutex);
+                    if (victim.begin == victim.end) {
+                        continue;
+                    }
+                    // take the upper half, rounded up such that a single remaining chunk can be stolen as well
+                    begin      = victim.begin + ((victim.end - victim.begin) / 2U);
+                    end        = victim.end;
+                    victim.end = begin;
+                }
+
+                auto&                 own = ranges[thief];
+                const std::lock_guard lock(own.mutex);
+                own.begin = begin;
+                own.end   = end;
+                return true;
+            }
+            return false;
+        };
+
+        std::vector<std::exception_ptr> errors(nThreads);
+        std::atomic<bool>               failed{false};
+
+        const auto work = [&ranges, &task, &steal, &failed](const unsigned thread) {
+            while (!failed.load(std::memory_order_relaxed)) {
+                std::size_t chunk{};
+                bool        found = false;
+                {
+                    auto&                 own = ranges[thread];
+                    const std::lock_guard lock(own.mutex);
+                    if (own.begin < own.end) {
+                        chunk = own.begin++;
+                        found = true;
+                    }
+                }
+                if (found) {
+                    task(thread, chunk);
+                } else if (!steal(thread)) {
+                    return;
+                }
+            }
+        };
+
+        // an exception must not leave a thread, it is handed to the calling thread instead
+        const auto worker = [&work, &errors, &failed](const unsigned thread) {
+            try {
+                work(thread);
+            } catch (...) {
+                errors[thread] = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads - 1U);
+        for (unsigned i = 1U; i < nThreads; ++i) {
+            threads.emplace_back(worker, i);
+        }
+        worker(0U);
+        for (auto& thread: threads) {
+            thread.join();
+        }
+        for (const auto& error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+} // namespace syrec
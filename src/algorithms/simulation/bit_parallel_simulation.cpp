@@ -0,0 +1,181 @@
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/simd_simulation.hpp"
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+#include "core/properties.hpp"
+#include "core/utils/timer.hpp"
+
+#include <algorithm>
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        // simulates rows of packed patterns in blocks as wide as the vector registers of the executing CPU
+        template<typename Word>
+        void packedSimulation(Word* outputs, const Word* inputs, const std::size_t nPatterns, const std::size_t stride, const CompiledCircuit& circ,
+                              const Properties::ptr& statistics) {
+            constexpr std::size_t wordBits = sizeof(Word) * 8U;
+
+            Timer<PropertiesTimer> t;
+
+            if (statistics) {
+                const PropertiesTimer rt(statistics);
+                t.start(rt);
+            }
+
+            const std::size_t nLines = circ.getLines();
+            if (stride < (nLines + wordBits - 1U) / wordBits) {
+                throw std::invalid_argument("The stride must hold all lines of the circuit");
+            }
+
+            const SimdLevel   level     = detectSimdLevel();
+            const std::size_t nWords    = simdWordsPerLine(level);
+            const std::size_t blockSize = nWords * PATTERNS_PER_WORD;
+
+            std::vector<PatternWord> lines(nLines * nWords);
+            for (std::size_t first = 0U; first < nPatterns; first += blockSize) {
+                const std::size_t count = std::min(blockSize, nPatterns - first);
+
+                // transpose the rows of this block into bit-sliced words
+                std::fill(lines.begin(), lines.end(), PatternWord{0U});
+                for (std::size_t k = 0U; k < count; ++k) {
+                    const Word*       row = inputs + ((first + k) * stride);
+                    const PatternWord bit = PatternWord{1U} << (k % PATTERNS_PER_WORD);
+                    for (std::size_t l = 0U; l < nLines; ++l) {
+                        if (((row[l / wordBits] >> (l % wordBits)) & 1U) != 0U) {
+                            lines[(l * nWords) + (k / PATTERNS_PER_WORD)] |= bit;
+                        }
+                    }
+                }
+
+                simdSimulation(lines, circ, level);
+
+                // transpose back into one row per pattern
+                for (std::size_t k = 0U; k < count; ++k) {
+                    Word* row = outputs + ((first + k) * stride);
+                    std::fill(row, row + stride, Word{0U});
+                    for (std::size_t l = 0U; l < nLines; ++l) {
+                        if (((lines[(l * nWords) + (k / PATTERNS_PER_WORD)] >> (k % PATTERNS_PER_WORD)) & 1U) != 0U) {
+                            row[l / wordBits] |= static_cast<Word>(Word{1U} << (l % wordBits));
+                        }
+                    }
+                }
+            }
+
+            if (statistics) {
+                t.stop();
+            }
+        }
+    } // namespace
+
+    void loadPatternBlock(std::vector<PatternWord>& lines, const boost::dynamic_bitset<>* patterns, const std::size_t count, const std::size_t nWords) {
+        const std::size_t nLines = lines.size() / nWords;
+        std::fill(lines.begin(), lines.end(), PatternWord{0U});
+        for (std::size_t k = 0U; k < count; ++k) {
+            const auto& pattern = patterns[k];
+            if (pattern.size() != nLines) {
+                throw std::invalid_argument("Every pattern must have as many bits as the circuit has lines");
+            }
+            for (auto l = pattern.find_first(); l != boost::dynamic_bitset<>::npos; l = pattern.find_next(l)) {
+                lines[(l * nWords) + (k / PATTERNS_PER_WORD)] |= PatternWord{1U} << (k % PATTERNS_PER_WORD);
+            }
+        }
+    }
+
+    void storePatternBlock(boost::dynamic_bitset<>* patterns, const std::vector<PatternWord>& lines, const std::size_t count, const std::size_t nWords) {
+        const std::size_t nLines = lines.size() / nWords;
+        for (std::size_t k = 0U; k < count; ++k) {
+            auto& pattern = patterns[k];
+            pattern.resize(nLines);
+            for (std::size_t l = 0U; l < nLines; ++l) {
+                pattern.set(l, ((lines[(l * nWords) + (k / PATTERNS_PER_WORD)] >> (k % PATTERNS_PER_WORD)) & 1U) != 0U);
+            }
+        }
+    }
+
+    void bitParallelGateSimulation(const Gate& g, std::vector<PatternWord>& lines) {
+        // patterns for which all controls are set
+        PatternWord active = ~PatternWord{0U};
+        for (const auto& c: g.controls) {
+            active &= lines[c];
+        }
+
+        if (g.type == Gate::Types::Toffoli) {
+            lines[*g.targets.begin()] ^= active;
+        } else if (g.type == Gate::Types::Fredkin) {
+            auto              it = g.targets.begin();
+            const std::size_t t1 = *it++;
+            const std::size_t t2 = *it;
+
+            // only swap where both targets differ
+            const PatternWord diff = (lines[t1] ^ lines[t2]) & active;
+            lines[t1] ^= diff;
+            lines[t2] ^= diff;
+        } else {
+            std::cerr << "Unknown gate: Simulation error\n";
+        }
+    }
+
+    void bitParallelSimulation(std::vector<PatternWord>& lines, const CompiledCircuit& circ) {
+        bitParallelSimulation(lines, circ, 0U, circ.numGates());
+    }
+
+    void bitParallelSimulation(std::vector<PatternWord>& lines, const CompiledCircuit& circ, const std::size_t first, const std::size_t last) {
+        bitParallelSimulation(lines, circ, first, last, [](std::size_t /*g*/, PatternWord /*active*/, PatternWord /*toggled*/) {});
+    }
+
+    void bitParallelSimulation(std::vector<boost::dynamic_bitset<>>& outputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                               const Properties::ptr& statistics) {
+        bitParallelSimulation(outputs, CompiledCircuit(circ), inputs, statistics);
+    }
+
+    void bitParallelSimulation(std::vector<boost::dynamic_bitset<>>& outputs, const CompiledCircuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                               const Properties::ptr& statistics) {
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        const std::size_t nLines = circ.getLines();
+        outputs.assign(inputs.size(), boost::dynamic_bitset<>(nLines));
+
+        // blocks are as wide as the vector registers of the executing CPU
+        const SimdLevel   level     = detectSimdLevel();
+        const std::size_t nWords    = simdWordsPerLine(level);
+        const std::size_t blockSize = nWords * PATTERNS_PER_WORD;
+
+        std::vector<PatternWord> lines(nLines * nWords);
+        for (std::size_t first = 0U; first < inputs.size(); first += blockSize) {
+            const std::size_t count = std::min(blockSize, inputs.size() - first);
+
+            loadPatternBlock(lines, inputs.data() + first, count, nWords);
+            simdSimulation(lines, circ, level);
+            storePatternBlock(outputs.data() + first, lines, count, nWords);
+        }
+
+        if (statistics) {
+            t.stop();
+        }
+    }
+
+    void bitParallelSimulation(std::uint8_t* outputs, const std::uint8_t* inputs, const std::size_t nPatterns, const std::size_t stride, const CompiledCircuit& circ,
+                               const Properties::ptr& statistics) {
+        packedSimulation(outputs, inputs, nPatterns, stride, circ, statistics);
+    }
+
+    void bitParallelSimulation(std::uint64_t* outputs, const std::uint64_t* inputs, const std::size_t nPatterns, const std::size_t stride, const CompiledCircuit& circ,
+                               const Properties::ptr& statistics) {
+        packedSimulation(outputs, inputs, nPatterns, stride, circ, statistics);
+    }
+
+} // namespace syrec
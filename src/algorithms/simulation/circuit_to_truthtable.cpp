@@ -1,54 +1,281 @@
 #include "algorithms/simulation/circuit_to_truthtable.hpp"
 
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/exhaustive_simulation.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
 #include "core/truthTable/truth_table.hpp"
+#include "core/utils/work_stealing.hpp"
 #include "dd/Package.hpp"
 #include "dd/Simulation.hpp"
 #include "ir/QuantumComputation.hpp"
+#include "ir/operations/Control.hpp"
+#include "ir/operations/OpType.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace syrec {
 
-    auto buildTruthTable(const qc::QuantumComputation& qc, TruthTable& tt) -> void {
-        const auto nBits = qc.getNqubits();
+    namespace {
+        using Word = std::uint64_t;
 
-        tt.setConstants(qc.getAncillary());
-        tt.setGarbage(qc.getGarbage());
+        constexpr std::size_t WORD_BITS = 64U;
+
+        // number of blocks of WORD_BITS inputs handed to a thread at once
+        constexpr std::uint64_t BLOCKS_PER_CHUNK = 16U;
+
+        // bit patterns of the six lowest input bits across the 64 lanes of a word
+        constexpr std::array<Word, 6U> LANE_PATTERNS = {
+                0xAAAAAAAAAAAAAAAAULL,
+                0xCCCCCCCCCCCCCCCCULL,
+                0xF0F0F0F0F0F0F0F0ULL,
+                0xFF00FF00FF00FF00ULL,
+                0xFFFF0000FFFF0000ULL,
+                0xFFFFFFFF00000000ULL};
+
+        // a reversible gate in a form that can be evaluated on bit-sliced words
+        struct ClassicalGate {
+            std::vector<qc::Qubit> posControls;
+            std::vector<qc::Qubit> negControls;
+            qc::Qubit              target1{};
+            qc::Qubit              target2{};
+            bool                   swap = false;
+        };
+
+        // extracts the gates of the circuit if it consists of single-target X/MCX and SWAP operations only
+        // and does not permute its qubits, otherwise returns false
+        auto extractClassicalGates(const qc::QuantumComputation& qc, std::vector<ClassicalGate>& gates) -> bool {
+            const auto isIdentity = [](const auto& permutation) {
+                return std::all_of(permutation.begin(), permutation.end(), [](const auto& p) { return p.first == p.second; });
+            };
+            if (!isIdentity(qc.initialLayout) || !isIdentity(qc.outputPermutation)) {
+                return false;
+            }
+
+            gates.reserve(qc.getNops());
+            for (const auto& op: qc) {
+                if (!op->isStandardOperation() || (op->getType() != qc::X && op->getType() != qc::SWAP)) {
+                    return false;
+                }
+
+                const auto& targets = op->getTargets();
+                if (targets.size() != (op->getType() == qc::SWAP ? 2U : 1U)) {
+                    return false;
+                }
+
+                ClassicalGate g;
+                for (const auto& control: op->getControls()) {
+                    (control.type == qc::Control::Type::Pos ? g.posControls : g.negControls).emplace_back(control.qubit);
+                }
+                g.target1 = targets.front();
+                g.swap    = op->getType() == qc::SWAP;
+                if (g.swap) {
+                    g.target2 = targets.back();
+                }
+                gates.emplace_back(std::move(g));
+            }
+            return true;
+        }
+
+        auto simulateWords(const std::vector<ClassicalGate>& gates, std::vector<Word>& lines) -> void {
+            for (const auto& g: gates) {
+                Word active = ~Word{0U};
+                for (const auto c: g.posControls) {
+                    active &= lines[c];
+                }
+                for (const auto c: g.negControls) {
+                    active &= ~lines[c];
+                }
+
+                if (g.swap) {
+                    const Word diff = (lines[g.target1] ^ lines[g.target2]) & active;
+                    lines[g.target1] ^= diff;
+                    lines[g.target2] ^= diff;
+                } else {
+                    lines[g.target1] ^= active;
+                }
+            }
+        }
+
+        // cube of lane k, the first character of a cube corresponds to the most significant qubit
+        auto laneToCube(const std::vector<Word>& lines, const std::size_t k) -> TruthTable::Cube {
+            TruthTable::Cube cube{};
+            cube.reserve(lines.size());
+            for (auto q = lines.size(); q > 0U; --q) {
+                cube.emplace_back(((lines[q - 1U] >> k) & 1U) != 0U);
+            }
+            return cube;
+        }
+
+        // simulates the blocks [firstBlock, lastBlock) of 64 consecutive primary input assignments each
+        auto simulateBlocks(const std::vector<ClassicalGate>& gates, const std::vector<qc::Qubit>& primaryInputs, const std::vector<bool>& garbage,
+                            const std::uint64_t nInputs, const std::uint64_t firstBlock, const std::uint64_t lastBlock,
+                            std::vector<std::pair<TruthTable::Cube, TruthTable::Cube>>& entries) -> void {
+            const auto        nBits = garbage.size();
+            std::vector<Word> in(nBits);
+            std::vector<Word> out(nBits);
+
+            for (auto block = firstBlock; block < lastBlock; ++block) {
+                const std::uint64_t base  = block * WORD_BITS;
+                const std::size_t   lanes = static_cast<std::size_t>(std::min<std::uint64_t>(WORD_BITS, nInputs - base));
+
+                // constant lines are initialized to zero
+                std::fill(in.begin(), in.end(), Word{0U});
+                for (std::size_t p = 0U; p < primaryInputs.size(); ++p) {
+                    if (p < LANE_PATTERNS.size()) {
+                        in[primaryInputs[p]] = LANE_PATTERNS[p];
+                    } else if (((base >> p) & 1U) != 0U) {
+                        in[primaryInputs[p]] = ~Word{0U};
+                    }
+                }
 
-        assert(nBits < 65U);
+                out = in;
+                simulateWords(gates, out);
 
-        auto dd = std::make_unique<dd::Package<>>(nBits);
+                // garbage outputs are reported as zero, matching the DD-based sampling
+                for (std::size_t q = 0U; q < nBits; ++q) {
+                    if (garbage[q]) {
+                        out[q] = 0U;
+                    }
+                }
+
+                for (std::size_t k = 0U; k < lanes; ++k) {
+                    entries.emplace_back(laneToCube(in, k), laneToCube(out, k));
+                }
+            }
+        }
 
-        const auto totalInputs = 1U << nBits;
+        auto buildTruthTableBitParallel(const std::vector<ClassicalGate>& gates, const std::size_t nBits, TruthTable& tt, const unsigned nThreads) -> void {
+            std::vector<qc::Qubit> primaryInputs;
+            for (std::size_t q = 0U; q < nBits; ++q) {
+                if (!tt.isConstant(q)) {
+                    primaryInputs.emplace_back(static_cast<qc::Qubit>(q));
+                }
+            }
+            if (primaryInputs.size() >= 64U) {
+                throw std::invalid_argument("Truth tables can only be built for at most 63 primary inputs");
+            }
 
-        std::uint64_t n = 0U;
+            std::vector<bool> garbage = tt.getGarbage();
+            garbage.resize(nBits, false);
 
-        while (n < totalInputs) {
-            const auto inCube = TruthTable::Cube::fromInteger(n, nBits);
-            ++n;
+            const std::uint64_t nInputs = 1ULL << primaryInputs.size();
+            const std::uint64_t nBlocks = (nInputs + WORD_BITS - 1U) / WORD_BITS;
+            const std::uint64_t nChunks = (nBlocks + BLOCKS_PER_CHUNK - 1U) / BLOCKS_PER_CHUNK;
+            const auto          threads = resolveThreadCount(nThreads);
 
-            const auto boolCube  = inCube.toBoolVec();
-            bool       nextInput = false;
+            // every thread collects the entries of the chunks it simulates, the results are merged afterwards
+            std::vector<std::vector<std::pair<TruthTable::Cube, TruthTable::Cube>>> entries(threads);
+            parallelForWorkStealing(static_cast<std::size_t>(nChunks), threads, [&](const unsigned thread, const std::size_t chunk) {
+                const std::uint64_t firstBlock = chunk * BLOCKS_PER_CHUNK;
+                const std::uint64_t lastBlock  = std::min(nBlocks, firstBlock + BLOCKS_PER_CHUNK);
+                simulateBlocks(gates, primaryInputs, garbage, nInputs, firstBlock, lastBlock, entries[thread]);
+            });
 
-            for (auto i = 0U; i < nBits; i++) {
-                if (tt.isConstant(i) && (boolCube[i])) {
-                    nextInput = true;
-                    break;
+            for (auto& threadEntries: entries) {
+                for (auto& [input, output]: threadEntries) {
+                    tt.try_emplace(std::move(input), std::move(output));
                 }
             }
+        }
+
+        auto buildTruthTableBySampling(const qc::QuantumComputation& qc, TruthTable& tt) -> void {
+            const auto nBits = qc.getNqubits();
+
+            assert(nBits < 65U);
+
+            auto dd = std::make_unique<dd::Package<>>(nBits);
+
+            const auto totalInputs = 1U << nBits;
+
+            std::uint64_t n = 0U;
+
+            while (n < totalInputs) {
+                const auto inCube = TruthTable::Cube::fromInteger(n, nBits);
+                ++n;
 
-            if (nextInput) {
-                continue;
+                const auto boolCube  = inCube.toBoolVec();
+                bool       nextInput = false;
+
+                for (auto i = 0U; i < nBits; i++) {
+                    if (tt.isConstant(i) && (boolCube[i])) {
+                        nextInput = true;
+                        break;
+                    }
+                }
+
+                if (nextInput) {
+                    continue;
+                }
+
+                auto const inEdge    = dd->makeBasisState(nBits, boolCube);
+                const auto out       = dd::sample(qc, inEdge, *dd, 1);
+                const auto outString = out.begin()->first;
+
+                tt.try_emplace(inCube, TruthTable::Cube::fromString(outString));
             }
+        }
+    } // namespace
 
-            auto const inEdge    = dd->makeBasisState(nBits, boolCube);
-            const auto out       = dd::sample(qc, inEdge, *dd, 1);
-            const auto outString = out.begin()->first;
+    auto buildTruthTable(const qc::QuantumComputation& qc, TruthTable& tt, const unsigned nThreads) -> void {
+        tt.setConstants(qc.getAncillary());
+        tt.setGarbage(qc.getGarbage());
 
-            tt.try_emplace(inCube, TruthTable::Cube::fromString(outString));
+        // reversible circuits are evaluated classically, 64 inputs at a time
+        if (std::vector<ClassicalGate> gates; extractClassicalGates(qc, gates)) {
+            buildTruthTableBitParallel(gates, qc.getNqubits(), tt, nThreads);
+            return;
         }
+
+        buildTruthTableBySampling(qc, tt);
+    }
+
+    auto buildTruthTable(const Circuit& circ, TruthTable& tt, const Properties::ptr& settings) -> void {
+        const auto        nLines    = circ.getLines();
+        const auto&       constants = circ.getConstants();
+        std::vector<bool> isConstant(nLines);
+        for (std::size_t l = 0U; l < nLines; ++l) {
+            isConstant[l] = constants[l].has_value();
+        }
+        tt.setConstants(isConstant);
+        tt.setGarbage(circ.getGarbage());
+        const auto& garbage = circ.getGarbage();
+
+        std::mutex mutex;
+        exhaustiveSimulation(
+                circ, [&](const std::uint64_t firstInput, const std::size_t count, const std::vector<PatternWord>& lines) {
+                    std::vector<std::pair<TruthTable::Cube, TruthTable::Cube>> entries;
+                    entries.reserve(count);
+                    for (std::size_t k = 0U; k < count; ++k) {
+                        const auto       input = exhaustiveInputPattern(circ, firstInput + k);
+                        TruthTable::Cube in{};
+                        TruthTable::Cube out{};
+                        in.reserve(nLines);
+                        out.reserve(nLines);
+                        for (auto l = nLines; l > 0U; --l) {
+                            // garbage outputs are reported as zero, like for a quantum computation
+                            const bool isGarbage = l - 1U < garbage.size() && garbage[l - 1U];
+                            in.emplace_back(input.test(l - 1U));
+                            out.emplace_back(!isGarbage && ((lines[l - 1U] >> k) & 1U) != 0U);
+                        }
+                        entries.emplace_back(std::move(in), std::move(out));
+                    }
+
+                    const std::lock_guard lock(mutex);
+                    for (auto& [in, out]: entries) {
+                        tt.try_emplace(std::move(in), std::move(out));
+                    }
+                },
+                settings);
     }
 
 } // namespace syrec
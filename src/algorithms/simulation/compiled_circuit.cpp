@@ -0,0 +1,60 @@
+#include "algorithms/simulation/compiled_circuit.hpp"
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include <cstddef>
+
+namespace syrec {
+
+    CompiledCircuit::CompiledCircuit(const Circuit& circ):
+        lines(circ.getLines()),
+        nMaskWords((static_cast<std::size_t>(circ.getLines()) + MASK_WORD_BITS - 1U) / MASK_WORD_BITS) {
+        const std::size_t nGates = circ.numGates();
+
+        types.reserve(nGates);
+        targets1.reserve(nGates);
+        targets2.reserve(nGates);
+        controlOffsets.reserve(nGates + 1U);
+        controlMasks.assign(nGates * nMaskWords, mask_word{0U});
+
+        // instances of sub-circuits are compiled in place without expanding them in the circuit
+        controlOffsets.emplace_back(0U);
+        circ.forEachGate([this](const Gate& g) {
+            mask_word* mask = controlMasks.data() + (types.size() * nMaskWords);
+            for (const auto& c: g.controls) {
+                controlLines.emplace_back(static_cast<line>(c));
+                mask[c / MASK_WORD_BITS] |= mask_word{1U} << (c % MASK_WORD_BITS);
+            }
+            controlOffsets.emplace_back(controlLines.size());
+
+            auto it = g.targets.begin();
+            targets1.emplace_back(it != g.targets.end() ? static_cast<line>(*it++) : 0U);
+            targets2.emplace_back(it != g.targets.end() ? static_cast<line>(*it) : 0U);
+            types.emplace_back(g.type);
+        });
+    }
+
+    CompiledCircuit CompiledCircuit::inverse() const {
+        CompiledCircuit inv;
+        inv.lines      = lines;
+        inv.nMaskWords = nMaskWords;
+
+        const std::size_t nGates = numGates();
+        inv.types.assign(types.crbegin(), types.crend());
+        inv.targets1.assign(targets1.crbegin(), targets1.crend());
+        inv.targets2.assign(targets2.crbegin(), targets2.crend());
+        inv.controlOffsets.reserve(nGates + 1U);
+        inv.controlLines.reserve(controlLines.size());
+        inv.controlMasks.reserve(controlMasks.size());
+
+        inv.controlOffsets.emplace_back(0U);
+        for (std::size_t g = nGates; g > 0U; --g) {
+            inv.controlLines.insert(inv.controlLines.end(), controlsBegin(g - 1U), controlsEnd(g - 1U));
+            inv.controlOffsets.emplace_back(inv.controlLines.size());
+            inv.controlMasks.insert(inv.controlMasks.end(), controlMask(g - 1U), controlMask(g - 1U) + nMaskWords);
+        }
+        return inv;
+    }
+
+} // namespace syrec
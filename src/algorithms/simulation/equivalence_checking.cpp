@@ -0,0 +1,245 @@
+#include "algorithms/simulation/equivalence_checking.hpp"
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/utils/timer.hpp"
+#include "core/utils/work_stealing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        using LinePairs = std::vector<std::pair<std::size_t, std::size_t>>;
+
+        // maps the names of the selected lines to their indices, fails on duplicate names
+        std::optional<std::map<std::string, std::size_t>> namedLines(const std::vector<std::string>& names, const std::vector<bool>& selected) {
+            std::map<std::string, std::size_t> lines;
+            for (std::size_t l = 0U; l < selected.size(); ++l) {
+                if (selected[l] && !lines.try_emplace(names[l], l).second) {
+                    return std::nullopt;
+                }
+            }
+            return lines;
+        }
+
+        // pairs the selected lines of both circuits by name, fails if the names differ
+        std::optional<LinePairs> alignLines(const std::vector<std::string>& names1, const std::vector<bool>& selected1,
+                                            const std::vector<std::string>& names2, const std::vector<bool>& selected2) {
+            const auto lines1 = namedLines(names1, selected1);
+            const auto lines2 = namedLines(names2, selected2);
+            if (!lines1 || !lines2 || lines1->size() != lines2->size()) {
+                return std::nullopt;
+            }
+
+            LinePairs pairs;
+            for (const auto& [name, l1]: *lines1) {
+                const auto it = lines2->find(name);
+                if (it == lines2->end()) {
+                    return std::nullopt;
+                }
+                pairs.emplace_back(l1, it->second);
+            }
+            // primary inputs are enumerated in ascending line order of the first circuit
+            std::sort(pairs.begin(), pairs.end());
+            return pairs;
+        }
+
+        std::vector<bool> primaryInputs(const Circuit& circ) {
+            const auto&       constants = circ.getConstants();
+            std::vector<bool> selected(circ.getLines());
+            for (std::size_t l = 0U; l < selected.size(); ++l) {
+                selected[l] = !constants[l];
+            }
+            return selected;
+        }
+
+        std::vector<bool> primaryOutputs(const Circuit& circ) {
+            const auto&       garbage = circ.getGarbage();
+            std::vector<bool> selected(circ.getLines());
+            for (std::size_t l = 0U; l < selected.size(); ++l) {
+                selected[l] = !garbage[l];
+            }
+            return selected;
+        }
+
+        void loadConstants(std::vector<PatternWord>& lines, const Circuit& circ) {
+            const auto& constants = circ.getConstants();
+            for (std::size_t l = 0U; l < lines.size(); ++l) {
+                lines[l] = constants[l] && *constants[l] ? ~PatternWord{0U} : PatternWord{0U};
+            }
+        }
+
+        // simulates blocks of 64 input assignments on both circuits and reports the first mismatch
+        class BlockComparator {
+        public:
+            BlockComparator(const Circuit& circ1, const Circuit& circ2, LinePairs inputs, LinePairs outputs):
+                circ1(circ1), compiled1(circ1), compiled2(circ2), inputs(std::move(inputs)), outputs(std::move(outputs)),
+                lines1(circ1.getLines()), lines2(circ2.getLines()) {
+                loadConstants(lines1, circ1);
+                loadConstants(lines2, circ2);
+            }
+
+            [[nodiscard]] std::size_t numInputs() const {
+                return inputs.size();
+            }
+
+            // one word of assignments per primary input, in the order of the first circuit
+            std::optional<boost::dynamic_bitset<>> compare(const std::vector<PatternWord>& words, std::vector<PatternWord>& state1, std::vector<PatternWord>& state2) const {
+                state1 = lines1;
+                state2 = lines2;
+                for (std::size_t p = 0U; p < inputs.size(); ++p) {
+                    state1[inputs[p].first]  = words[p];
+                    state2[inputs[p].second] = words[p];
+                }
+
+                bitParallelSimulation(state1, compiled1);
+                bitParallelSimulation(state2, compiled2);
+
+                PatternWord diff = 0U;
+                for (const auto& [o1, o2]: outputs) {
+                    diff |= state1[o1] ^ state2[o2];
+                }
+                if (diff == 0U) {
+                    return std::nullopt;
+                }
+
+                // the input pattern of the first mismatching assignment
+                std::size_t k = 0U;
+                while (((diff >> k) & 1U) == 0U) {
+                    ++k;
+                }
+                boost::dynamic_bitset<> pattern(circ1.getLines());
+                for (std::size_t l = 0U; l < pattern.size(); ++l) {
+                    pattern.set(l, ((lines1[l] >> k) & 1U) != 0U);
+                }
+                for (std::size_t p = 0U; p < inputs.size(); ++p) {
+                    pattern.set(inputs[p].first, ((words[p] >> k) & 1U) != 0U);
+                }
+                return pattern;
+            }
+
+        private:
+            const Circuit&           circ1;
+            CompiledCircuit          compiled1;
+            CompiledCircuit          compiled2;
+            LinePairs                inputs;
+            LinePairs                outputs;
+            std::vector<PatternWord> lines1;
+            std::vector<PatternWord> lines2;
+        };
+
+        // runs the blocks [0, nBlocks) on the thread pool, stops at the first counterexample
+        template<typename LoadBlock>
+        std::optional<boost::dynamic_bitset<>> compareBlocks(const BlockComparator& comparator, const std::uint64_t nBlocks, const unsigned nThreads, const unsigned chunkSize,
+                                                             const LoadBlock& loadBlock) {
+            struct Scratch {
+                std::vector<PatternWord> words;
+                std::vector<PatternWord> state1;
+                std::vector<PatternWord> state2;
+            };
+            std::vector<Scratch> scratch(nThreads, Scratch{std::vector<PatternWord>(comparator.numInputs()), {}, {}});
+
+            std::atomic<bool>                      found{false};
+            std::mutex                             mutex;
+            std::optional<boost::dynamic_bitset<>> counterexample;
+
+            const std::uint64_t nChunks = (nBlocks + chunkSize - 1U) / chunkSize;
+            parallelForWorkStealing(static_cast<std::size_t>(nChunks), nThreads, [&](const unsigned thread, const std::size_t chunk) {
+                auto&               s         = scratch[thread];
+                const std::uint64_t lastBlock = std::min<std::uint64_t>(nBlocks, (chunk + 1U) * chunkSize);
+                for (std::uint64_t block = chunk * chunkSize; block < lastBlock && !found.load(std::memory_order_relaxed); ++block) {
+                    loadBlock(s.words, block);
+                    if (auto pattern = comparator.compare(s.words, s.state1, s.state2)) {
+                        const std::lock_guard lock(mutex);
+                        if (!found.exchange(true)) {
+                            counterexample = std::move(pattern);
+                        }
+                    }
+                }
+            });
+
+            return counterexample;
+        }
+    } // namespace
+
+    EquivalenceResult checkEquivalence(boost::dynamic_bitset<>& counterexample, const Circuit& circ1, const Circuit& circ2,
+                                       const Properties::ptr& settings, const Properties::ptr& statistics) {
+        // Settings parsing
+        const auto randomPatterns   = get<unsigned>(settings, "random_patterns", 65536U);
+        const auto seed             = get<unsigned>(settings, "seed", 0U);
+        const auto exhaustiveInputs = std::min(get<unsigned>(settings, "exhaustive_inputs", 24U), 63U);
+        const auto nThreads         = resolveThreadCount(get<unsigned>(settings, "num_threads", 0U));
+        const auto chunkSize        = std::max(1U, get<unsigned>(settings, "chunk_size", 16U));
+
+        // Run-time measuring
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        auto result = EquivalenceResult::IncompatibleInterfaces;
+
+        auto inputs  = alignLines(circ1.getInputs(), primaryInputs(circ1), circ2.getInputs(), primaryInputs(circ2));
+        auto outputs = alignLines(circ1.getOutputs(), primaryOutputs(circ1), circ2.getOutputs(), primaryOutputs(circ2));
+        if (inputs && outputs) {
+            const BlockComparator comparator(circ1, circ2, std::move(*inputs), std::move(*outputs));
+            const std::size_t     nInputs = comparator.numInputs();
+
+            // random simulation, every block draws from its own generator such that the result does not depend on the threads
+            const std::uint64_t nRandomBlocks = (std::uint64_t{randomPatterns} + PATTERNS_PER_WORD - 1U) / PATTERNS_PER_WORD;
+            auto                mismatch      = compareBlocks(comparator, nRandomBlocks, nThreads, chunkSize, [seed](std::vector<PatternWord>& words, const std::uint64_t block) {
+                std::mt19937_64 rng(std::uint64_t{seed} ^ (block * 0x9E3779B97F4A7C15ULL));
+                std::generate(words.begin(), words.end(), [&rng]() { return rng(); });
+            });
+
+            // exhaustive simulation, bit p of the assignment index belongs to the p-th primary input
+            if (!mismatch && nInputs <= exhaustiveInputs && nInputs < 64U) {
+                const std::uint64_t nPatterns = std::uint64_t{1U} << nInputs;
+                mismatch                      = compareBlocks(comparator, (nPatterns + PATTERNS_PER_WORD - 1U) / PATTERNS_PER_WORD, nThreads, chunkSize, [nPatterns](std::vector<PatternWord>& words, const std::uint64_t block) {
+                    const std::uint64_t base = block * PATTERNS_PER_WORD;
+                    std::fill(words.begin(), words.end(), PatternWord{0U});
+                    for (std::size_t k = 0U; k < PATTERNS_PER_WORD; ++k) {
+                        // lanes past the last assignment repeat it
+                        const std::uint64_t index = std::min(base + k, nPatterns - 1U);
+                        for (std::size_t p = 0U; p < words.size(); ++p) {
+                            words[p] |= ((index >> p) & 1U) << k;
+                        }
+                    }
+                });
+                if (!mismatch) {
+                    result = EquivalenceResult::Equivalent;
+                }
+            } else if (!mismatch) {
+                result = EquivalenceResult::ProbablyEquivalent;
+            }
+
+            if (mismatch) {
+                counterexample = std::move(*mismatch);
+                result         = EquivalenceResult::NotEquivalent;
+            }
+        }
+
+        if (statistics) {
+            t.stop();
+        }
+
+        return result;
+    }
+
+} // namespace syrec
@@ -0,0 +1,132 @@
+#include "algorithms/simulation/exhaustive_simulation.hpp"
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/utils/timer.hpp"
+#include "core/utils/work_stealing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        // bit patterns of the six lowest index bits across the lanes of a word
+        constexpr std::array<PatternWord, 6U> LANE_PATTERNS = {
+                0xAAAAAAAAAAAAAAAAULL,
+                0xCCCCCCCCCCCCCCCCULL,
+                0xF0F0F0F0F0F0F0F0ULL,
+                0xFF00FF00FF00FF00ULL,
+                0xFFFF0000FFFF0000ULL,
+                0xFFFFFFFF00000000ULL};
+
+        // loads the inputs [base, base + 64) into bit-sliced words
+        void loadInputBlock(std::vector<PatternWord>& lines, const std::vector<constant>& constants, const std::uint64_t base) {
+            std::size_t p = 0U;
+            for (std::size_t l = 0U; l < lines.size(); ++l) {
+                if (constants[l]) {
+                    lines[l] = *constants[l] ? ~PatternWord{0U} : PatternWord{0U};
+                } else if (p < LANE_PATTERNS.size()) {
+                    lines[l] = LANE_PATTERNS[p++];
+                } else {
+                    lines[l] = ((base >> p++) & 1U) != 0U ? ~PatternWord{0U} : PatternWord{0U};
+                }
+            }
+        }
+
+        // the patterns are enumerated by a 64-bit index
+        void requireEnumerableInputs(const std::size_t nInputs) {
+            if (nInputs >= 64U) {
+                throw std::invalid_argument("Exhaustive simulation supports at most 63 primary inputs");
+            }
+        }
+    } // namespace
+
+    std::size_t numPrimaryInputs(const Circuit& circ) {
+        const auto& constants = circ.getConstants();
+        return static_cast<std::size_t>(std::count(constants.cbegin(), constants.cend(), constant()));
+    }
+
+    boost::dynamic_bitset<> exhaustiveInputPattern(const Circuit& circ, const std::uint64_t index) {
+        const auto&             constants = circ.getConstants();
+        boost::dynamic_bitset<> pattern(circ.getLines());
+        std::size_t             p = 0U;
+        for (std::size_t l = 0U; l < pattern.size(); ++l) {
+            pattern.set(l, constants[l] ? *constants[l] : ((index >> p++) & 1U) != 0U);
+        }
+        return pattern;
+    }
+
+    void exhaustiveSimulation(const Circuit& circ, const ExhaustiveSimulationSink& sink, const Properties::ptr& settings, const Properties::ptr& statistics) {
+        // Settings parsing
+        const auto nThreads  = resolveThreadCount(get<unsigned>(settings, "num_threads", 0U));
+        const auto chunkSize = std::max(1U, get<unsigned>(settings, "chunk_size", 16U));
+
+        // Run-time measuring
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        const auto nInputs = numPrimaryInputs(circ);
+        requireEnumerableInputs(nInputs);
+
+        const CompiledCircuit compiled(circ);
+        const auto&           constants = circ.getConstants();
+        const std::uint64_t   nPatterns = 1ULL << nInputs;
+        const std::uint64_t   nBlocks   = (nPatterns + PATTERNS_PER_WORD - 1U) / PATTERNS_PER_WORD;
+        const std::uint64_t   nChunks   = (nBlocks + chunkSize - 1U) / chunkSize;
+
+        // per-thread simulation state
+        std::vector<std::vector<PatternWord>> scratch(nThreads, std::vector<PatternWord>(circ.getLines()));
+
+        parallelForWorkStealing(static_cast<std::size_t>(nChunks), nThreads, [&](const unsigned thread, const std::size_t chunk) {
+            auto&               lines     = scratch[thread];
+            const std::uint64_t lastBlock = std::min<std::uint64_t>(nBlocks, (chunk + 1U) * chunkSize);
+            for (std::uint64_t block = chunk * chunkSize; block < lastBlock; ++block) {
+                const std::uint64_t base = block * PATTERNS_PER_WORD;
+                loadInputBlock(lines, constants, base);
+                bitParallelSimulation(lines, compiled);
+                sink(base, static_cast<std::size_t>(std::min<std::uint64_t>(PATTERNS_PER_WORD, nPatterns - base)), lines);
+            }
+        });
+
+        if (statistics) {
+            t.stop();
+        }
+    }
+
+    void exhaustiveSimulation(std::vector<std::uint64_t>& outputs, const Circuit& circ, const Properties::ptr& settings, const Properties::ptr& statistics) {
+        const std::size_t nLines  = circ.getLines();
+        const auto        nInputs = numPrimaryInputs(circ);
+        // checked before shifting, the sink overload would only notice after the output array has been sized
+        requireEnumerableInputs(nInputs);
+        const std::size_t wordsPerPattern = (nLines + PATTERNS_PER_WORD - 1U) / PATTERNS_PER_WORD;
+        if ((std::uint64_t{1U} << nInputs) > outputs.max_size() / std::max<std::size_t>(wordsPerPattern, 1U)) {
+            throw std::length_error("The outputs of the exhaustive simulation do not fit into memory");
+        }
+        outputs.assign((std::size_t{1U} << nInputs) * wordsPerPattern, 0U);
+
+        // every block writes a disjoint range of the output array
+        exhaustiveSimulation(
+                circ, [&](const std::uint64_t firstInput, const std::size_t count, const std::vector<PatternWord>& lines) {
+                    for (std::size_t k = 0U; k < count; ++k) {
+                        std::uint64_t* pattern = outputs.data() + ((firstInput + k) * wordsPerPattern);
+                        for (std::size_t l = 0U; l < nLines; ++l) {
+                            pattern[l / PATTERNS_PER_WORD] |= ((lines[l] >> k) & 1U) << (l % PATTERNS_PER_WORD);
+                        }
+                    }
+                },
+                settings, statistics);
+    }
+
+} // namespace syrec
@@ -0,0 +1,257 @@
+#include "algorithms/simulation/fault_simulation.hpp"
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/exhaustive_simulation.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/utils/timer.hpp"
+#include "core/utils/work_stealing.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        // fault simulation of one block of bit-sliced patterns
+        class BlockFaultSimulator {
+        public:
+            // the state in front of every interval-th gate is kept, 0 selects an interval such that at most about 1024 states are kept
+            BlockFaultSimulator(const Circuit& circ, const std::size_t interval):
+                compiled(circ), nLines(circ.getLines()), nGates(compiled.numGates()),
+                interval(interval != 0U ? interval : std::max<std::size_t>(1U, nGates / 1024U)),
+                checkpoints(((nGates / this->interval) + 1U) * nLines), outputs(nLines) {}
+
+            // simulates the fault-free circuit and records the checkpoints and the outputs
+            void simulate(const std::vector<PatternWord>& inputs) {
+                std::vector<PatternWord> state = inputs;
+                for (std::size_t c = 0U; c * interval <= nGates; ++c) {
+                    if (c != 0U) {
+                        bitParallelSimulation(state, compiled, (c - 1U) * interval, c * interval);
+                    }
+                    std::copy(state.cbegin(), state.cend(), checkpoints.begin() + static_cast<std::ptrdiff_t>(c * nLines));
+                }
+                bitParallelSimulation(state, compiled, (nGates / interval) * interval, nGates);
+                outputs = state;
+            }
+
+            // returns the patterns of the block whose outputs differ under the fault
+            PatternWord detect(const Fault& f, std::vector<PatternWord>& state) const {
+                // the state in front of the faulty gate is restored from the nearest checkpoint
+                const std::size_t c      = f.gate / interval;
+                const auto        before = checkpoints.cbegin() + static_cast<std::ptrdiff_t>(c * nLines);
+                state.assign(before, before + static_cast<std::ptrdiff_t>(nLines));
+                bitParallelSimulation(state, compiled, c * interval, f.gate);
+
+                switch (f.type) {
+                    case Fault::Types::MissingGate:
+                        bitParallelSimulation(state, compiled, f.gate + 1U, nGates);
+                        break;
+                    case Fault::Types::RepeatedGate:
+                        bitParallelSimulation(state, compiled, f.gate, f.gate + 1U);
+                        bitParallelSimulation(state, compiled, f.gate, nGates);
+                        break;
+                    case Fault::Types::StuckAt0:
+                    case Fault::Types::StuckAt1:
+                        state[f.line] = f.type == Fault::Types::StuckAt1 ? ~PatternWord{0U} : PatternWord{0U};
+                        bitParallelSimulation(state, compiled, f.gate, nGates);
+                        break;
+                }
+
+                PatternWord diff = 0U;
+                for (std::size_t l = 0U; l < nLines; ++l) {
+                    diff |= state[l] ^ outputs[l];
+                }
+                return diff;
+            }
+
+        private:
+            CompiledCircuit          compiled;
+            std::size_t              nLines;
+            std::size_t              nGates;
+            std::size_t              interval;
+            std::vector<PatternWord> checkpoints;
+            std::vector<PatternWord> outputs;
+        };
+
+        // returns the patterns of the block that detect each pending fault
+        void detectPendingFaults(std::vector<PatternWord>& masks, const BlockFaultSimulator& simulator, const std::vector<Fault>& faults, const std::vector<std::size_t>& pending,
+                                 const std::size_t nLines, const unsigned nThreads, const std::size_t chunkSize) {
+            masks.assign(pending.size(), 0U);
+            std::vector<std::vector<PatternWord>> scratch(nThreads, std::vector<PatternWord>(nLines));
+
+            parallelForWorkStealing((pending.size() + chunkSize - 1U) / chunkSize, nThreads, [&](const unsigned thread, const std::size_t chunk) {
+                const std::size_t last = std::min(pending.size(), (chunk + 1U) * chunkSize);
+                for (std::size_t i = chunk * chunkSize; i < last; ++i) {
+                    masks[i] = simulator.detect(faults[pending[i]], scratch[thread]);
+                }
+            });
+        }
+
+        double coverage(const std::size_t nDetected, const std::size_t nFaults) {
+            return nFaults == 0U ? 1.0 : static_cast<double>(nDetected) / static_cast<double>(nFaults);
+        }
+    } // namespace
+
+    std::vector<Fault> enumerateFaults(const Circuit& circ) {
+        const std::size_t  nGates = circ.numGates();
+        std::vector<Fault> faults;
+        faults.reserve((2U * nGates) + (2U * (nGates + 1U) * circ.getLines()));
+
+        for (std::size_t g = 0U; g < nGates; ++g) {
+            faults.emplace_back(Fault{Fault::Types::MissingGate, g, 0U});
+            faults.emplace_back(Fault{Fault::Types::RepeatedGate, g, 0U});
+        }
+        for (std::size_t g = 0U; g <= nGates; ++g) {
+            for (Gate::line l = 0U; l < circ.getLines(); ++l) {
+                faults.emplace_back(Fault{Fault::Types::StuckAt0, g, l});
+                faults.emplace_back(Fault{Fault::Types::StuckAt1, g, l});
+            }
+        }
+        return faults;
+    }
+
+    double faultSimulation(std::vector<bool>& detected, const Circuit& circ, const std::vector<Fault>& faults, const std::vector<boost::dynamic_bitset<>>& tests,
+                           const Properties::ptr& settings, const Properties::ptr& statistics) {
+        // Settings parsing
+        const auto nThreads  = resolveThreadCount(get<unsigned>(settings, "num_threads", 0U));
+        const auto chunkSize = std::max(1U, get<unsigned>(settings, "chunk_size", 64U));
+        const auto interval  = get<unsigned>(settings, "checkpoint_interval", 0U);
+
+        // Run-time measuring
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        detected.assign(faults.size(), false);
+        std::vector<std::size_t> pending(faults.size());
+        std::iota(pending.begin(), pending.end(), 0U);
+
+        BlockFaultSimulator      simulator(circ, interval);
+        std::vector<PatternWord> lines(circ.getLines());
+        std::vector<PatternWord> masks;
+        for (std::size_t first = 0U; first < tests.size() && !pending.empty(); first += PATTERNS_PER_WORD) {
+            const std::size_t count = std::min(PATTERNS_PER_WORD, tests.size() - first);
+            loadPatternBlock(lines, tests.data() + first, count);
+            simulator.simulate(lines);
+
+            const PatternWord valid = count == PATTERNS_PER_WORD ? ~PatternWord{0U} : (PatternWord{1U} << count) - 1U;
+            detectPendingFaults(masks, simulator, faults, pending, circ.getLines(), nThreads, chunkSize);
+
+            // drop the detected faults
+            std::size_t kept = 0U;
+            for (std::size_t i = 0U; i < pending.size(); ++i) {
+                if ((masks[i] & valid) != 0U) {
+                    detected[pending[i]] = true;
+                } else {
+                    pending[kept++] = pending[i];
+                }
+            }
+            pending.resize(kept);
+        }
+
+        const double result = coverage(faults.size() - pending.size(), faults.size());
+
+        if (statistics) {
+            t.stop();
+            statistics->set("coverage", result);
+        }
+
+        return result;
+    }
+
+    double generateTestSet(std::vector<boost::dynamic_bitset<>>& tests, const Circuit& circ, const std::vector<Fault>& faults,
+                           const Properties::ptr& settings, const Properties::ptr& statistics) {
+        // Settings parsing
+        const auto exhaustiveInputs = get<unsigned>(settings, "exhaustive_inputs", 20U);
+        const auto randomPatterns   = get<unsigned>(settings, "random_patterns", 65536U);
+        const auto seed             = get<unsigned>(settings, "seed", 0U);
+        const auto nThreads         = resolveThreadCount(get<unsigned>(settings, "num_threads", 0U));
+        const auto chunkSize        = std::max(1U, get<unsigned>(settings, "chunk_size", 64U));
+        const auto interval         = get<unsigned>(settings, "checkpoint_interval", 0U);
+
+        // Run-time measuring
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        tests.clear();
+        std::vector<std::size_t> pending(faults.size());
+        std::iota(pending.begin(), pending.end(), 0U);
+
+        const auto          nInputs     = numPrimaryInputs(circ);
+        const bool          exhaustive  = nInputs <= exhaustiveInputs && nInputs < 64U;
+        const std::uint64_t nCandidates = exhaustive ? (std::uint64_t{1U} << nInputs) : randomPatterns;
+        const auto&         constants   = circ.getConstants();
+        std::mt19937_64     rng(seed);
+
+        BlockFaultSimulator                                    simulator(circ, interval);
+        std::array<boost::dynamic_bitset<>, PATTERNS_PER_WORD> candidates;
+        std::vector<PatternWord>                               lines(circ.getLines());
+        std::vector<PatternWord>                               masks;
+        for (std::uint64_t first = 0U; first < nCandidates && !pending.empty(); first += PATTERNS_PER_WORD) {
+            const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(PATTERNS_PER_WORD, nCandidates - first));
+            for (std::size_t k = 0U; k < count; ++k) {
+                if (exhaustive) {
+                    candidates[k] = exhaustiveInputPattern(circ, first + k);
+                } else {
+                    candidates[k] = boost::dynamic_bitset<>(circ.getLines());
+                    for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+                        candidates[k].set(l, constants[l] ? *constants[l] : (rng() & 1U) != 0U);
+                    }
+                }
+            }
+            loadPatternBlock(lines, candidates.data(), count);
+            simulator.simulate(lines);
+            detectPendingFaults(masks, simulator, faults, pending, circ.getLines(), nThreads, chunkSize);
+
+            // greedily pick the candidate that detects the most pending faults
+            while (!pending.empty()) {
+                std::array<std::size_t, PATTERNS_PER_WORD> hits{};
+                for (const auto mask: masks) {
+                    for (std::size_t k = 0U; k < count; ++k) {
+                        hits[k] += (mask >> k) & 1U;
+                    }
+                }
+                const auto best = static_cast<std::size_t>(std::max_element(hits.cbegin(), hits.cbegin() + static_cast<std::ptrdiff_t>(count)) - hits.cbegin());
+                if (hits[best] == 0U) {
+                    break;
+                }
+                tests.emplace_back(candidates[best]);
+
+                std::size_t kept = 0U;
+                for (std::size_t i = 0U; i < pending.size(); ++i) {
+                    if (((masks[i] >> best) & 1U) == 0U) {
+                        pending[kept] = pending[i];
+                        masks[kept++] = masks[i];
+                    }
+                }
+                pending.resize(kept);
+                masks.resize(kept);
+            }
+        }
+
+        const double result = coverage(faults.size() - pending.size(), faults.size());
+
+        if (statistics) {
+            t.stop();
+            statistics->set("coverage", result);
+        }
+
+        return result;
+    }
+
+} // namespace syrec
@@ -0,0 +1,113 @@
+#include "algorithms/simulation/inverse_simulation.hpp"
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/utils/timer.hpp"
+
+#include <algorithm>
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace syrec {
+
+    void inverseSimulation(boost::dynamic_bitset<>& input, const Circuit& circ, const boost::dynamic_bitset<>& output, const Properties::ptr& statistics) {
+        simpleSimulation(input, CompiledCircuit(circ).inverse(), output, statistics);
+    }
+
+    void inverseBitParallelSimulation(std::vector<boost::dynamic_bitset<>>& inputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& outputs,
+                                      const Properties::ptr& statistics) {
+        bitParallelSimulation(inputs, CompiledCircuit(circ).inverse(), outputs, statistics);
+    }
+
+    bool isFeasiblePreimage(const Circuit& circ, const boost::dynamic_bitset<>& input) {
+        const auto& constants = circ.getConstants();
+        for (std::size_t l = 0U; l < constants.size(); ++l) {
+            if (constants[l] && input.test(l) != *constants[l]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool findPreimages(std::vector<boost::dynamic_bitset<>>& inputs, const Circuit& circ, const boost::dynamic_bitset<>& output, const Properties::ptr& settings,
+                       const Properties::ptr& statistics) {
+        // Settings parsing
+        const auto maxGarbageLines = std::min(get<unsigned>(settings, "max_garbage_lines", 24U), 63U);
+
+        // Run-time measuring
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        const std::size_t nLines    = circ.getLines();
+        const auto&       constants = circ.getConstants();
+        const auto&       garbage   = circ.getGarbage();
+
+        std::vector<std::size_t> garbageLines;
+        for (std::size_t l = 0U; l < nLines; ++l) {
+            if (l < garbage.size() && garbage[l]) {
+                garbageLines.emplace_back(l);
+            }
+        }
+        if (garbageLines.size() > maxGarbageLines) {
+            throw std::invalid_argument("Preimages are only enumerated for at most " + std::to_string(maxGarbageLines) + " garbage lines");
+        }
+
+        const CompiledCircuit    inverse = CompiledCircuit(circ).inverse();
+        const std::uint64_t      nAssignments{std::uint64_t{1U} << garbageLines.size()};
+        std::vector<PatternWord> lines(nLines);
+
+        inputs.clear();
+        for (std::uint64_t base = 0U; base < nAssignments; base += PATTERNS_PER_WORD) {
+            const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(PATTERNS_PER_WORD, nAssignments - base));
+
+            // the non-garbage outputs are fixed, the garbage outputs enumerate base, base + 1, ...
+            for (std::size_t l = 0U; l < nLines; ++l) {
+                lines[l] = output.test(l) ? ~PatternWord{0U} : PatternWord{0U};
+            }
+            for (std::size_t p = 0U; p < garbageLines.size(); ++p) {
+                PatternWord& word = lines[garbageLines[p]];
+                word              = 0U;
+                for (std::size_t k = 0U; k < count; ++k) {
+                    word |= (((base + k) >> p) & 1U) << k;
+                }
+            }
+
+            bitParallelSimulation(lines, inverse);
+
+            // patterns whose constant lines hold their constant values
+            PatternWord feasible = count == PATTERNS_PER_WORD ? ~PatternWord{0U} : (PatternWord{1U} << count) - 1U;
+            for (std::size_t l = 0U; l < nLines && l < constants.size(); ++l) {
+                if (constants[l]) {
+                    feasible &= *constants[l] ? lines[l] : ~lines[l];
+                }
+            }
+
+            for (std::size_t k = 0U; k < count; ++k) {
+                if (((feasible >> k) & 1U) != 0U) {
+                    auto& input = inputs.emplace_back(nLines);
+                    for (std::size_t l = 0U; l < nLines; ++l) {
+                        input.set(l, ((lines[l] >> k) & 1U) != 0U);
+                    }
+                }
+            }
+        }
+
+        if (statistics) {
+            t.stop();
+        }
+
+        return !inputs.empty();
+    }
+
+} // namespace syrec
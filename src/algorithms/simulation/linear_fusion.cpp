@@ -0,0 +1,183 @@
+#include "algorithms/simulation/linear_fusion.hpp"
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+#include "core/properties.hpp"
+#include "core/utils/timer.hpp"
+
+#include <algorithm>
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        constexpr std::size_t NO_LAYER = std::numeric_limits<std::size_t>::max();
+
+        bool isLinear(const Gate& g) {
+            return (g.type == Gate::Types::Toffoli && g.controls.size() <= 1U) || (g.type == Gate::Types::Fredkin && g.controls.empty());
+        }
+
+        // the value of a line as affine function of the line values in front of a run
+        struct AffineFunction {
+            boost::dynamic_bitset<> row;
+            bool                    constant = false;
+        };
+    } // namespace
+
+    FusedCircuit::FusedCircuit(const Circuit& circ, const std::size_t minRunLength) {
+        const std::size_t nLines = circ.getLines();
+
+        Circuit remaining;
+        remaining.setLines(circ.getLines());
+
+        std::vector<Gate> run;
+        std::size_t       firstGate = 0U;
+
+        const auto keep = [&]() {
+            for (const auto& g: run) {
+                remaining.appendGate() = g;
+            }
+            run.clear();
+        };
+
+        const auto flush = [&]() {
+            if (run.size() < std::max<std::size_t>(minRunLength, 1U)) {
+                keep();
+                return;
+            }
+
+            // compose the affine functions of all lines changed by the run
+            std::map<std::size_t, AffineFunction> functions;
+            const auto                            function = [&](const std::size_t l) -> AffineFunction& {
+                auto [it, inserted] = functions.try_emplace(l);
+                if (inserted) {
+                    it->second.row.resize(nLines);
+                    it->second.row.set(l);
+                }
+                return it->second;
+            };
+            for (const auto& g: run) {
+                auto it = g.targets.begin();
+                if (g.type == Gate::Types::Fredkin) {
+                    const auto t1 = *it++;
+                    std::swap(function(t1), function(*it));
+                } else if (g.controls.empty()) {
+                    function(*it).constant ^= true;
+                } else {
+                    const auto source = function(*g.controls.begin());
+                    auto&      target = function(*it);
+                    target.row ^= source.row;
+                    target.constant ^= source.constant;
+                }
+            }
+
+            AffineLayer layer;
+            layer.sourceOffsets.emplace_back(0U);
+            for (const auto& [l, f]: functions) {
+                // skip lines that the run leaves unchanged
+                if (!f.constant && f.row.count() == 1U && f.row.test(l)) {
+                    continue;
+                }
+                layer.targets.emplace_back(static_cast<CompiledCircuit::line>(l));
+                layer.constants.emplace_back(f.constant);
+                for (auto s = f.row.find_first(); s != boost::dynamic_bitset<>::npos; s = f.row.find_next(s)) {
+                    layer.sources.emplace_back(static_cast<CompiledCircuit::line>(s));
+                }
+                layer.sourceOffsets.emplace_back(layer.sources.size());
+            }
+
+            // a layer takes one XOR per set matrix entry, so the run is only fused if this is cheaper than its gates
+            if (layer.sources.size() >= run.size()) {
+                keep();
+                return;
+            }
+
+            steps.emplace_back(Step{firstGate, remaining.numGates(), layers.size()});
+            firstGate = remaining.numGates();
+            layers.emplace_back(std::move(layer));
+            fusedGates += run.size();
+            run.clear();
+        };
+
+        // instances are fused through their mapped gates, without being expanded
+        circ.forEachGate([&](const Gate& g) {
+            if (isLinear(g)) {
+                run.emplace_back(g);
+            } else {
+                flush();
+                remaining.appendGate() = g;
+            }
+        });
+        flush();
+        if (firstGate < remaining.numGates()) {
+            steps.emplace_back(Step{firstGate, remaining.numGates(), NO_LAYER});
+        }
+
+        gates = CompiledCircuit(remaining);
+    }
+
+    void FusedCircuit::simulate(std::vector<PatternWord>& lines) const {
+        std::vector<PatternWord> values;
+        for (const auto& step: steps) {
+            bitParallelSimulation(lines, gates, step.firstGate, step.lastGate);
+            if (step.layer == NO_LAYER) {
+                continue;
+            }
+
+            // all targets are computed from the values in front of the layer
+            const auto& layer = layers[step.layer];
+            values.assign(layer.targets.size(), PatternWord{0U});
+            for (std::size_t i = 0U; i < layer.targets.size(); ++i) {
+                PatternWord value = layer.constants[i] ? ~PatternWord{0U} : PatternWord{0U};
+                for (std::size_t j = layer.sourceOffsets[i]; j < layer.sourceOffsets[i + 1U]; ++j) {
+                    value ^= lines[layer.sources[j]];
+                }
+                values[i] = value;
+            }
+            for (std::size_t i = 0U; i < layer.targets.size(); ++i) {
+                lines[layer.targets[i]] = values[i];
+            }
+        }
+    }
+
+    void fusedSimulation(std::vector<boost::dynamic_bitset<>>& outputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                         const Properties::ptr& settings, const Properties::ptr& statistics) {
+        // Settings parsing
+        const auto minRunLength = get<unsigned>(settings, "min_run_length", 2U);
+
+        // Run-time measuring
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        const FusedCircuit fused(circ, minRunLength);
+        const std::size_t  nLines = circ.getLines();
+        outputs.assign(inputs.size(), boost::dynamic_bitset<>(nLines));
+
+        std::vector<PatternWord> lines(nLines);
+        for (std::size_t first = 0U; first < inputs.size(); first += PATTERNS_PER_WORD) {
+            const std::size_t count = std::min(PATTERNS_PER_WORD, inputs.size() - first);
+
+            loadPatternBlock(lines, inputs.data() + first, count);
+            fused.simulate(lines);
+            storePatternBlock(outputs.data() + first, lines, count);
+        }
+
+        if (statistics) {
+            t.stop();
+            statistics->set("fused_gates", static_cast<unsigned>(fused.numFusedGates()));
+            statistics->set("layers", static_cast<unsigned>(fused.numLayers()));
+        }
+    }
+
+} // namespace syrec
@@ -0,0 +1,85 @@
+#include "algorithms/simulation/profiling_simulation.hpp"
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+#include "core/properties.hpp"
+#include "core/utils/timer.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <boost/dynamic_bitset/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        std::uint64_t popcount(const PatternWord w) {
+            return std::bitset<PATTERNS_PER_WORD>(w).count();
+        }
+    } // namespace
+
+    void profilingSimulation(SimulationProfile& profile, std::vector<boost::dynamic_bitset<>>& outputs, const Circuit& circ, const std::vector<boost::dynamic_bitset<>>& inputs,
+                             const Properties::ptr& statistics) {
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        const CompiledCircuit compiled(circ);
+        const std::size_t     nLines = circ.getLines();
+        const std::size_t     nGates = compiled.numGates();
+
+        profile          = SimulationProfile();
+        profile.patterns = inputs.size();
+        profile.gateActivations.assign(nGates, 0U);
+        profile.lineToggles.assign(nLines, 0U);
+        std::vector<std::uint64_t> gateToggles(nGates, 0U);
+
+        outputs.assign(inputs.size(), boost::dynamic_bitset<>(nLines));
+
+        std::vector<PatternWord> lines(nLines);
+        for (std::size_t first = 0U; first < inputs.size(); first += PATTERNS_PER_WORD) {
+            const std::size_t count = std::min(PATTERNS_PER_WORD, inputs.size() - first);
+            const PatternWord valid = count == PATTERNS_PER_WORD ? ~PatternWord{0U} : (PatternWord{1U} << count) - 1U;
+
+            loadPatternBlock(lines, inputs.data() + first, count);
+
+            bitParallelSimulation(lines, compiled, 0U, nGates, [&](const std::size_t g, const PatternWord active, const PatternWord toggled) {
+                const auto nToggled = popcount(toggled & valid);
+                profile.gateActivations[g] += popcount(active & valid);
+                profile.lineToggles[compiled.target1(g)] += nToggled;
+                gateToggles[g] += nToggled;
+                if (compiled.type(g) == Gate::Types::Fredkin) {
+                    profile.lineToggles[compiled.target2(g)] += nToggled;
+                    gateToggles[g] += nToggled;
+                }
+            });
+
+            storePatternBlock(outputs.data() + first, lines, count);
+        }
+
+        // aggregate by the source line the gates have been synthesized from, the gates of instances carry
+        // the annotations of the sub-circuit and are visited in the order of the compiled circuit
+        std::size_t g = 0U;
+        circ.forEachGateWithOrigin([&](const Gate& /*gate*/, const Circuit& owner, const Gate& original) {
+            if (const auto lno = owner.getUnsignedAnnotation(original, "lno")) {
+                auto& activity = profile.sourceLines[*lno];
+                ++activity.gates;
+                activity.activations += profile.gateActivations[g];
+                activity.toggles += gateToggles[g];
+            }
+            ++g;
+        });
+
+        if (statistics) {
+            t.stop();
+        }
+    }
+
+} // namespace syrec
@@ -0,0 +1,188 @@
+#include "algorithms/simulation/simd_simulation.hpp"
+
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "core/gate.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+// the vectorized kernels are compiled for their target via function attributes,
+// such that the library itself does not require AVX2 or AVX-512 support
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SYREC_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace syrec {
+
+    namespace {
+        // portable kernel on W words per line, also used if the CPU lacks the requested instruction set
+        template<std::size_t W>
+        void simulateWords(PatternWord* lines, const CompiledCircuit& circ) {
+            for (std::size_t g = 0U; g < circ.numGates(); ++g) {
+                // patterns for which all controls are set
+                std::array<PatternWord, W> active{};
+                active.fill(~PatternWord{0U});
+                for (const auto* c = circ.controlsBegin(g); c != circ.controlsEnd(g); ++c) {
+                    for (std::size_t w = 0U; w < W; ++w) {
+                        active[w] &= lines[(*c * W) + w];
+                    }
+                }
+
+                if (circ.type(g) == Gate::Types::Toffoli) {
+                    PatternWord* t = lines + (circ.target1(g) * W);
+                    for (std::size_t w = 0U; w < W; ++w) {
+                        t[w] ^= active[w];
+                    }
+                } else if (circ.type(g) == Gate::Types::Fredkin) {
+                    PatternWord* t1 = lines + (circ.target1(g) * W);
+                    PatternWord* t2 = lines + (circ.target2(g) * W);
+                    for (std::size_t w = 0U; w < W; ++w) {
+                        // only swap where both targets differ
+                        const PatternWord diff = (t1[w] ^ t2[w]) & active[w];
+                        t1[w] ^= diff;
+                        t2[w] ^= diff;
+                    }
+                } else {
+                    std::cerr << "Unknown gate: Simulation error\n";
+                }
+            }
+        }
+
+#ifdef SYREC_SIMD_X86
+        __attribute__((target("avx2"))) void simulateAvx2(PatternWord* lines, const CompiledCircuit& circ) {
+            constexpr std::size_t w    = 4U;
+            const auto            line = [lines](const std::size_t l) { return reinterpret_cast<__m256i*>(lines + (l * w)); };
+
+            for (std::size_t g = 0U; g < circ.numGates(); ++g) {
+                // patterns for which all controls are set
+                __m256i active = _mm256_set1_epi64x(-1);
+                for (const auto* c = circ.controlsBegin(g); c != circ.controlsEnd(g); ++c) {
+                    active = _mm256_and_si256(active, _mm256_loadu_si256(line(*c)));
+                }
+
+                if (circ.type(g) == Gate::Types::Toffoli) {
+                    auto* t = line(circ.target1(g));
+                    _mm256_storeu_si256(t, _mm256_xor_si256(_mm256_loadu_si256(t), active));
+                } else if (circ.type(g) == Gate::Types::Fredkin) {
+                    auto*         t1 = line(circ.target1(g));
+                    auto*         t2 = line(circ.target2(g));
+                    const __m256i v1 = _mm256_loadu_si256(t1);
+                    const __m256i v2 = _mm256_loadu_si256(t2);
+
+                    // only swap where both targets differ
+                    const __m256i diff = _mm256_and_si256(_mm256_xor_si256(v1, v2), active);
+                    _mm256_storeu_si256(t1, _mm256_xor_si256(v1, diff));
+                    _mm256_storeu_si256(t2, _mm256_xor_si256(v2, diff));
+                } else {
+                    std::cerr << "Unknown gate: Simulation error\n";
+                }
+            }
+        }
+
+        __attribute__((target("avx512f"))) void simulateAvx512(PatternWord* lines, const CompiledCircuit& circ) {
+            constexpr std::size_t w    = 8U;
+            const auto            line = [lines](const std::size_t l) { return lines + (l * w); };
+
+            for (std::size_t g = 0U; g < circ.numGates(); ++g) {
+                // patterns for which all controls are set
+                __m512i active = _mm512_set1_epi64(-1);
+                for (const auto* c = circ.controlsBegin(g); c != circ.controlsEnd(g); ++c) {
+                    active = _mm512_and_si512(active, _mm512_loadu_si512(line(*c)));
+                }
+
+                if (circ.type(g) == Gate::Types::Toffoli) {
+                    auto* t = line(circ.target1(g));
+                    _mm512_storeu_si512(t, _mm512_xor_si512(_mm512_loadu_si512(t), active));
+                } else if (circ.type(g) == Gate::Types::Fredkin) {
+                    auto*         t1 = line(circ.target1(g));
+                    auto*         t2 = line(circ.target2(g));
+                    const __m512i v1 = _mm512_loadu_si512(t1);
+                    const __m512i v2 = _mm512_loadu_si512(t2);
+
+                    // only swap where both targets differ
+                    const __m512i diff = _mm512_and_si512(_mm512_xor_si512(v1, v2), active);
+                    _mm512_storeu_si512(t1, _mm512_xor_si512(v1, diff));
+                    _mm512_storeu_si512(t2, _mm512_xor_si512(v2, diff));
+                } else {
+                    std::cerr << "Unknown gate: Simulation error\n";
+                }
+            }
+        }
+
+        bool isSupported(const SimdLevel level) {
+            const auto available = detectSimdLevel();
+            switch (level) {
+                case SimdLevel::Scalar:
+                    return true;
+                case SimdLevel::AVX2:
+                    return available == SimdLevel::AVX2 || available == SimdLevel::AVX512;
+                case SimdLevel::AVX512:
+                    return available == SimdLevel::AVX512;
+            }
+            return false;
+        }
+#endif
+    } // namespace
+
+    SimdLevel detectSimdLevel() {
+#ifdef SYREC_SIMD_X86
+        static const SimdLevel level = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") != 0) {
+                return SimdLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2") != 0) {
+                return SimdLevel::AVX2;
+            }
+            return SimdLevel::Scalar;
+        }();
+        return level;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    std::size_t simdWordsPerLine(const SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2:
+                return 4U;
+            case SimdLevel::AVX512:
+                return 8U;
+            default:
+                return 1U;
+        }
+    }
+
+    void simdSimulation(std::vector<PatternWord>& lines, const CompiledCircuit& circ, const SimdLevel level) {
+        assert(lines.size() == circ.getLines() * simdWordsPerLine(level));
+
+        switch (level) {
+            case SimdLevel::AVX2:
+#ifdef SYREC_SIMD_X86
+                if (isSupported(level)) {
+                    simulateAvx2(lines.data(), circ);
+                    break;
+                }
+#endif
+                simulateWords<4U>(lines.data(), circ);
+                break;
+            case SimdLevel::AVX512:
+#ifdef SYREC_SIMD_X86
+                if (isSupported(level)) {
+                    simulateAvx512(lines.data(), circ);
+                    break;
+                }
+#endif
+                simulateWords<8U>(lines.data(), circ);
+                break;
+            default:
+                bitParallelSimulation(lines, circ);
+        }
+    }
+
+} // namespace syrec
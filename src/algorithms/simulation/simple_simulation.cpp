@@ -1,16 +1,188 @@
 #include "algorithms/simulation/simple_simulation.hpp"
 
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/exhaustive_simulation.hpp"
+#include "algorithms/simulation/fixed_width_simulation.hpp"
 #include "core/circuit.hpp"
 #include "core/gate.hpp"
 #include "core/properties.hpp"
 #include "core/utils/timer.hpp"
 
+#include <algorithm>
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 namespace syrec {
 
+    namespace {
+        // simulates the gates [first, last) on a pattern of arbitrary width
+        void simulateDynamicWidth(boost::dynamic_bitset<>& pattern, const CompiledCircuit& circ, const std::size_t first, const std::size_t last) {
+            for (std::size_t g = first; g < last; ++g) {
+                const auto type = circ.type(g);
+                if (type != Gate::Types::Toffoli && type != Gate::Types::Fredkin) {
+                    std::cerr << "Unknown gate: Simulation error\n";
+                    continue;
+                }
+
+                if (!std::all_of(circ.controlsBegin(g), circ.controlsEnd(g), [&pattern](const auto c) { return pattern.test(c); })) {
+                    continue;
+                }
+
+                if (type == Gate::Types::Toffoli) {
+                    pattern.flip(circ.target1(g));
+                } else {
+                    const bool t1v = pattern.test(circ.target1(g));
+                    const bool t2v = pattern.test(circ.target2(g));
+
+                    // only swap when different
+                    if (t1v != t2v) {
+                        pattern.set(circ.target1(g), t2v);
+                        pattern.set(circ.target2(g), t1v);
+                    }
+                }
+            }
+        }
+
+        template<std::size_t N>
+        void simulateFixedWidth(boost::dynamic_bitset<>& output, const CompiledCircuit& circ, const boost::dynamic_bitset<>& input) {
+            auto state = toFixedWidthState<N>(input);
+            fixedWidthSimulation<N>(state, circ);
+            // bits of wider inputs beyond the state are passed through unchanged
+            output = input;
+            fromFixedWidthState<N>(output, state);
+        }
+
+        // state operations used by the exhaustive simulation for circuits of up to N * 64 lines
+        template<std::size_t N>
+        struct FixedWidthKernel {
+            using State = FixedWidthState<N>;
+
+            static State load(const boost::dynamic_bitset<>& pattern) {
+                return toFixedWidthState<N>(pattern);
+            }
+            static void flip(State& state, const std::size_t l) {
+                state[l / CompiledCircuit::MASK_WORD_BITS] ^= CompiledCircuit::mask_word{1U} << (l % CompiledCircuit::MASK_WORD_BITS);
+            }
+            static void simulate(State& state, const CompiledCircuit& circ, const std::size_t first, const std::size_t last) {
+                fixedWidthSimulation<N>(state, circ, first, last);
+            }
+            static void store(boost::dynamic_bitset<>& pattern, const State& state) {
+                fromFixedWidthState<N>(pattern, state);
+            }
+        };
+
+        // state operations used by the exhaustive simulation for wider circuits
+        struct DynamicWidthKernel {
+            using State = boost::dynamic_bitset<>;
+
+            static State load(const boost::dynamic_bitset<>& pattern) {
+                return pattern;
+            }
+            static void flip(State& state, const std::size_t l) {
+                state.flip(l);
+            }
+            static void simulate(State& state, const CompiledCircuit& circ, const std::size_t first, const std::size_t last) {
+                simulateDynamicWidth(state, circ, first, last);
+            }
+            static void store(boost::dynamic_bitset<>& pattern, const State& state) {
+                pattern = state;
+            }
+        };
+
+        // returns for every line the index of the first gate that touches it
+        std::vector<std::size_t> firstGateOnLines(const CompiledCircuit& circ) {
+            std::vector<std::size_t> first(circ.getLines(), circ.numGates());
+            for (std::size_t g = circ.numGates(); g > 0U; --g) {
+                std::for_each(circ.controlsBegin(g - 1U), circ.controlsEnd(g - 1U), [&](const auto c) { first[c] = g - 1U; });
+                first[circ.target1(g - 1U)] = g - 1U;
+                if (circ.type(g - 1U) == Gate::Types::Fredkin) {
+                    first[circ.target2(g - 1U)] = g - 1U;
+                }
+            }
+            return first;
+        }
+
+        template<typename Kernel>
+        void exhaustiveSimulationInBinaryOrder(const Circuit& circ, const CompiledCircuit& compiled, const std::uint64_t nPatterns, const ExhaustiveSimulationCallback& sink) {
+            boost::dynamic_bitset<> output(circ.getLines());
+            for (std::uint64_t index = 0U; index < nPatterns; ++index) {
+                auto state = Kernel::load(exhaustiveInputPattern(circ, index));
+                Kernel::simulate(state, compiled, 0U, compiled.numGates());
+                Kernel::store(output, state);
+                sink(index, output);
+            }
+        }
+
+        // Walks the inputs in Gray-code order, such that consecutive inputs differ in a single line.
+        // The state before every interval-th gate is kept as a checkpoint. Since no gate in front of
+        // the first gate on the flipped line can observe it, the checkpoints up to that gate remain
+        // valid after flipping the line in them, and the simulation resumes from the last of them.
+        template<typename Kernel>
+        void exhaustiveSimulationInGrayCodeOrder(const Circuit& circ, const CompiledCircuit& compiled, const std::uint64_t nPatterns, std::size_t interval, const ExhaustiveSimulationCallback& sink) {
+            const std::size_t nGates = compiled.numGates();
+            if (interval == 0U) {
+                interval = std::max<std::size_t>(1U, nGates / 1024U);
+            }
+
+            std::vector<std::size_t> primaryLines;
+            const auto&              constants = circ.getConstants();
+            for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+                if (!constants[l]) {
+                    primaryLines.emplace_back(l);
+                }
+            }
+            const auto firstGate = firstGateOnLines(compiled);
+
+            std::vector<typename Kernel::State> checkpoints((nGates / interval) + 1U, Kernel::load(exhaustiveInputPattern(circ, 0U)));
+            boost::dynamic_bitset<>             output(circ.getLines());
+
+            // simulates from checkpoint j to the end, refreshing all later checkpoints
+            const auto resume = [&](std::size_t j) {
+                auto state = checkpoints[j];
+                for (++j; j < checkpoints.size(); ++j) {
+                    Kernel::simulate(state, compiled, (j - 1U) * interval, j * interval);
+                    checkpoints[j] = state;
+                }
+                Kernel::simulate(state, compiled, (checkpoints.size() - 1U) * interval, nGates);
+                Kernel::store(output, state);
+            };
+
+            resume(0U);
+            sink(0U, output);
+
+            std::uint64_t index = 0U;
+            for (std::uint64_t i = 1U; i < nPatterns; ++i) {
+                // the primary input flipped between the Gray codes of i - 1 and i
+                std::size_t p = 0U;
+                while (((i >> p) & 1U) == 0U) {
+                    ++p;
+                }
+                index ^= 1ULL << p;
+
+                const auto        line = primaryLines[p];
+                const std::size_t last = std::min(firstGate[line] / interval, checkpoints.size() - 1U);
+                for (std::size_t j = 0U; j <= last; ++j) {
+                    Kernel::flip(checkpoints[j], line);
+                }
+                resume(last);
+                sink(index, output);
+            }
+        }
+
+        template<typename Kernel>
+        void exhaustiveSimulation(const Circuit& circ, const CompiledCircuit& compiled, const std::uint64_t nPatterns, const bool grayCode, const std::size_t interval, const ExhaustiveSimulationCallback& sink) {
+            if (grayCode) {
+                exhaustiveSimulationInGrayCodeOrder<Kernel>(circ, compiled, nPatterns, interval, sink);
+            } else {
+                exhaustiveSimulationInBinaryOrder<Kernel>(circ, compiled, nPatterns, sink);
+            }
+        }
+    } // namespace
+
     void coreGateSimulation(const Gate& g, boost::dynamic_bitset<>& input) {
         if (g.type == Gate::Types::Toffoli) {
             boost::dynamic_bitset<> cMask(input.size());
@@ -49,6 +221,11 @@ namespace syrec {
 
     void simpleSimulation(boost::dynamic_bitset<>& output, const Circuit& circ, const boost::dynamic_bitset<>& input,
                           const Properties::ptr& statistics) {
+        simpleSimulation(output, CompiledCircuit(circ), input, statistics);
+    }
+
+    void simpleSimulation(boost::dynamic_bitset<>& output, const CompiledCircuit& circ, const boost::dynamic_bitset<>& input,
+                          const Properties::ptr& statistics) {
         Timer<PropertiesTimer> t;
 
         if (statistics) {
@@ -56,9 +233,66 @@ namespace syrec {
             t.start(rt);
         }
 
-        output = input;
-        for (const auto& g: circ) {
-            coreGateSimulation(*g, output);
+        // circuits with few lines are simulated allocation-free on a fixed-width state
+        switch (circ.maskWords()) {
+            case 1U:
+                simulateFixedWidth<1U>(output, circ, input);
+                break;
+            case 2U:
+                simulateFixedWidth<2U>(output, circ, input);
+                break;
+            case 3U:
+                simulateFixedWidth<3U>(output, circ, input);
+                break;
+            case MAX_FIXED_WIDTH_WORDS:
+                simulateFixedWidth<MAX_FIXED_WIDTH_WORDS>(output, circ, input);
+                break;
+            default:
+                output = input;
+                simulateDynamicWidth(output, circ, 0U, circ.numGates());
+        }
+
+        if (statistics) {
+            t.stop();
+        }
+    }
+
+    void exhaustiveSimpleSimulation(const Circuit& circ, const ExhaustiveSimulationCallback& sink, const Properties::ptr& settings,
+                                    const Properties::ptr& statistics) {
+        // Settings parsing
+        const auto grayCode = get<bool>(settings, "gray_code", true);
+        const auto interval = get<unsigned>(settings, "checkpoint_interval", 0U);
+
+        // Run-time measuring
+        Timer<PropertiesTimer> t;
+
+        if (statistics) {
+            const PropertiesTimer rt(statistics);
+            t.start(rt);
+        }
+
+        const auto nInputs = numPrimaryInputs(circ);
+        if (nInputs >= 64U) {
+            throw std::invalid_argument("Exhaustive simulation supports at most 63 primary inputs");
+        }
+        const std::uint64_t nPatterns = 1ULL << nInputs;
+
+        const CompiledCircuit compiled(circ);
+        switch (compiled.maskWords()) {
+            case 1U:
+                exhaustiveSimulation<FixedWidthKernel<1U>>(circ, compiled, nPatterns, grayCode, interval, sink);
+                break;
+            case 2U:
+                exhaustiveSimulation<FixedWidthKernel<2U>>(circ, compiled, nPatterns, grayCode, interval, sink);
+                break;
+            case 3U:
+                exhaustiveSimulation<FixedWidthKernel<3U>>(circ, compiled, nPatterns, grayCode, interval, sink);
+                break;
+            case MAX_FIXED_WIDTH_WORDS:
+                exhaustiveSimulation<FixedWidthKernel<MAX_FIXED_WIDTH_WORDS>>(circ, compiled, nPatterns, grayCode, interval, sink);
+                break;
+            default:
+                exhaustiveSimulation<DynamicWidthKernel>(circ, compiled, nPatterns, grayCode, interval, sink);
         }
 
         if (statistics) {
@@ -11,6 +11,7 @@
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
 #include <numeric>
 #include <stack>
+#include <utility>
 
 namespace syrec {
 
@@ -22,7 +23,7 @@ namespace syrec {
         // Operator needs this signature to work
         void operator()(Gate const& g) const {
             if (!stmts.empty()) {
-                circ.annotate(g, "lno", std::to_string(stmts.top()->lineNumber));
+                circ.annotate(g, "lno", stmts.top()->lineNumber);
             }
         }
 
@@ -882,7 +883,8 @@ namespace syrec {
     bool SyrecSynthesis::assembleCircuit(const cct_node& current) {
         // leaf
         if (out_edges(current, cctMan.tree).first == out_edges(current, cctMan.tree).second /*get( boost::vertex_name, cctMan.tree )[current].circ.get()->num_gates() > 0u*/) {
-            circ.insertCircuit(circ.numGates(), *(get(boost::vertex_name, cctMan.tree)[current].circ), get(boost::vertex_name, cctMan.tree)[current].controls);
+            // the leaf is not needed anymore, so its gates are handed over instead of copied
+            circ.insertCircuit(circ.numGates(), std::move(*(get(boost::vertex_name, cctMan.tree)[current].circ)), get(boost::vertex_name, cctMan.tree)[current].controls);
             return true;
         }
         // assemble optimized circuits of successors
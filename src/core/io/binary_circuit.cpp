@@ -0,0 +1,373 @@
+#include "core/io/binary_circuit.hpp"
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        // Layout of version 1, all sections start at multiples of 8 bytes:
+        //   header       magic, version, byte order, lines, flags, number of gates and line indices, section offsets
+        //   lines        one constant byte (0, 1, or NO_CONSTANT) and one garbage byte per line
+        //   names        input names, then output names, each as u32 length and characters
+        //   gates        one GATE_RECORD_SIZE byte record per gate: u64 first line index, u32 controls, u8 targets, u8 type
+        //   indices      u32 lines of all gates, the controls of a gate followed by its targets
+        //   annotations  u64 count, then u64 gate, u8 kind, key and value (a string, or a u32 number for kind 1)
+        constexpr std::array<char, 8> MAGIC            = {'S', 'Y', 'R', 'E', 'C', 'B', 'I', 'N'};
+        constexpr std::uint32_t       VERSION          = 1U;
+        constexpr std::uint32_t       BYTE_ORDER_MARK  = 0x01020304U;
+        constexpr std::uint32_t       FLAG_ANNOTATIONS = 1U;
+        constexpr std::size_t         HEADER_SIZE      = 64U;
+        constexpr std::size_t         GATE_RECORD_SIZE = 16U;
+        constexpr std::uint8_t        NO_CONSTANT      = 0xFFU;
+        constexpr std::uint8_t        STRING_VALUE     = 0U;
+        constexpr std::uint8_t        NUMBER_VALUE     = 1U;
+
+        constexpr std::size_t align(const std::size_t offset) {
+            return (offset + 7U) & ~std::size_t{7U};
+        }
+
+        template<typename T>
+        void put(std::string& buffer, const T value) {
+            std::array<char, sizeof(T)> bytes{};
+            std::memcpy(bytes.data(), &value, sizeof(T));
+            buffer.append(bytes.data(), sizeof(T));
+        }
+
+        void putString(std::string& buffer, const std::string& s) {
+            put(buffer, static_cast<std::uint32_t>(s.size()));
+            buffer += s;
+        }
+
+        // the gates accepted by MappedCircuit: Toffoli gates with one target and Fredkin gates with two targets
+        bool isValidGate(const std::uint8_t type, const std::size_t nTargets) {
+            return (type == static_cast<std::uint8_t>(Gate::Types::Toffoli) && nTargets == 1U) || (type == static_cast<std::uint8_t>(Gate::Types::Fredkin) && nTargets == 2U);
+        }
+
+        // rejects circuits that MappedCircuit would not read back, before anything is written
+        void validateGates(const Circuit& circ) {
+            const auto  nLines = circ.getLines();
+            std::size_t i      = 0U;
+            circ.forEachGate([nLines, &i](const Gate& g) {
+                const bool validLines = std::all_of(g.controls.begin(), g.controls.end(), [nLines](const auto l) { return l < nLines; }) &&
+                                        std::all_of(g.targets.begin(), g.targets.end(), [nLines](const auto l) { return l < nLines; });
+                if (!isValidGate(static_cast<std::uint8_t>(g.type), g.targets.size()) || g.controls.size() > std::numeric_limits<std::uint32_t>::max() || !validLines) {
+                    throw std::invalid_argument("Gate " + std::to_string(i) + " cannot be written in the binary circuit format");
+                }
+                ++i;
+            });
+        }
+
+        void flush(std::ostream& os, std::string& buffer) {
+            os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+
+        // decimal numbers which the annotation table can store without a string
+        bool isNumber(const std::string& s, std::uint32_t& value) {
+            if (s.empty() || (s.size() > 1U && s.front() == '0')) {
+                return false;
+            }
+            const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+            return ec == std::errc() && end == s.data() + s.size() && value != std::numeric_limits<std::uint32_t>::max();
+        }
+
+        // bounds-checked sequential reads from the mapped file
+        class Reader {
+        public:
+            Reader(const std::byte* data, const std::size_t size, const std::size_t offset):
+                data(data), size(size), offset(offset) {}
+
+            template<typename T>
+            T get() {
+                require(sizeof(T));
+                T value{};
+                std::memcpy(&value, data + offset, sizeof(T));
+                offset += sizeof(T);
+                return value;
+            }
+
+            std::string getString() {
+                const auto length = get<std::uint32_t>();
+                require(length);
+                std::string s(reinterpret_cast<const char*>(data + offset), length);
+                offset += length;
+                return s;
+            }
+
+        private:
+            void require(const std::size_t n) const {
+                if (n > size - offset) {
+                    throw std::runtime_error("Binary circuit file is truncated");
+                }
+            }
+
+            const std::byte* data;
+            std::size_t      size;
+            std::size_t      offset;
+        };
+
+        // writes a circuit that has passed validateGates
+        void writeValidBinary(std::ostream& os, const Circuit& circ, const bool annotations) {
+            const auto nLines = circ.getLines();
+
+            std::uint64_t nIndices = 0U;
+            circ.forEachGate([&nIndices](const Gate& g) {
+                nIndices += g.controls.size() + g.targets.size();
+            });
+
+            std::string buffer;
+            for (unsigned l = 0U; l < nLines; ++l) {
+                const auto& c = circ.getConstants()[l];
+                put(buffer, c ? static_cast<std::uint8_t>(*c) : NO_CONSTANT);
+                put(buffer, static_cast<std::uint8_t>(circ.getGarbage()[l]));
+            }
+            for (const auto* names: {&circ.getInputs(), &circ.getOutputs()}) {
+                for (unsigned l = 0U; l < nLines; ++l) {
+                    putString(buffer, (*names)[l]);
+                }
+            }
+            buffer.resize(align(HEADER_SIZE + buffer.size()) - HEADER_SIZE, '\0');
+
+            const std::uint64_t gatesOffset       = HEADER_SIZE + buffer.size();
+            const std::uint64_t indicesOffset     = gatesOffset + (GATE_RECORD_SIZE * circ.numGates());
+            const std::uint64_t annotationsOffset = annotations ? align(indicesOffset + (sizeof(std::uint32_t) * nIndices)) : 0U;
+
+            std::string header(MAGIC.data(), MAGIC.size());
+            put(header, VERSION);
+            put(header, BYTE_ORDER_MARK);
+            put(header, static_cast<std::uint32_t>(nLines));
+            put(header, annotations ? FLAG_ANNOTATIONS : 0U);
+            put(header, static_cast<std::uint64_t>(circ.numGates()));
+            put(header, nIndices);
+            put(header, gatesOffset);
+            put(header, indicesOffset);
+            put(header, annotationsOffset);
+            os.write(header.data(), static_cast<std::streamsize>(header.size()));
+            flush(os, buffer);
+
+            constexpr std::size_t flushSize = 1U << 16U;
+            std::uint64_t         index     = 0U;
+            circ.forEachGate([&](const Gate& g) {
+                put(buffer, index);
+                put(buffer, static_cast<std::uint32_t>(g.controls.size()));
+                put(buffer, static_cast<std::uint8_t>(g.targets.size()));
+                put(buffer, static_cast<std::uint8_t>(g.type));
+                put(buffer, std::uint16_t{0U});
+                index += g.controls.size() + g.targets.size();
+                if (buffer.size() >= flushSize) {
+                    flush(os, buffer);
+                }
+            });
+            circ.forEachGate([&](const Gate& g) {
+                for (const auto* lines: {&g.controls, &g.targets}) {
+                    for (const auto l: *lines) {
+                        put(buffer, static_cast<std::uint32_t>(l));
+                    }
+                }
+                if (buffer.size() >= flushSize) {
+                    flush(os, buffer);
+                }
+            });
+
+            if (annotations) {
+                buffer.resize(buffer.size() + (annotationsOffset - indicesOffset - (sizeof(std::uint32_t) * nIndices)), '\0');
+
+                std::uint64_t nAnnotations = 0U;
+                circ.forEachGateWithOrigin([&nAnnotations](const Gate& /*g*/, const Circuit& owner, const Gate& original) {
+                    if (const auto a = owner.getAnnotations(original)) {
+                        nAnnotations += a->size();
+                    }
+                });
+                put(buffer, nAnnotations);
+
+                std::uint64_t gateIndex = 0U;
+                circ.forEachGateWithOrigin([&](const Gate& /*g*/, const Circuit& owner, const Gate& original) {
+                    if (const auto a = owner.getAnnotations(original)) {
+                        for (const auto& [key, value]: *a) {
+                            put(buffer, gateIndex);
+                            std::uint32_t number{};
+                            const bool    numeric = isNumber(value, number);
+                            put(buffer, numeric ? NUMBER_VALUE : STRING_VALUE);
+                            putString(buffer, key);
+                            if (numeric) {
+                                put(buffer, number);
+                            } else {
+                                putString(buffer, value);
+                            }
+                        }
+                    }
+                    ++gateIndex;
+                    if (buffer.size() >= flushSize) {
+                        flush(os, buffer);
+                    }
+                });
+            }
+            flush(os, buffer);
+        }
+    } // namespace
+
+    void writeBinary(std::ostream& os, const Circuit& circ, const bool annotations) {
+        validateGates(circ);
+        writeValidBinary(os, circ, annotations);
+    }
+
+    bool toBinaryFile(const Circuit& circ, const std::string& filename, const bool annotations) {
+        validateGates(circ);
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            return false; // GCOVR_EXCL_LINE
+        }
+        writeValidBinary(file, circ, annotations);
+        file.close();
+        return true;
+    }
+
+    MappedCircuit::MappedCircuit(const std::string& filename) {
+        try {
+            file   = boost::interprocess::file_mapping(filename.c_str(), boost::interprocess::read_only);
+            region = boost::interprocess::mapped_region(file, boost::interprocess::read_only);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Cannot map binary circuit file " + filename + ": " + e.what());
+        }
+
+        const auto size = region.get_size();
+        Reader     header(data(), size, 0U);
+        const auto magic = header.get<std::array<char, 8>>();
+        if (magic != MAGIC) {
+            throw std::runtime_error(filename + " is not a binary circuit file");
+        }
+        if (header.get<std::uint32_t>() != VERSION) {
+            throw std::runtime_error("Unsupported version of binary circuit file " + filename);
+        }
+        if (header.get<std::uint32_t>() != BYTE_ORDER_MARK) {
+            throw std::runtime_error("Binary circuit file " + filename + " has been written with a different byte order");
+        }
+        lines                    = header.get<std::uint32_t>();
+        const auto flags         = header.get<std::uint32_t>();
+        const auto gates         = header.get<std::uint64_t>();
+        const auto nIndices      = header.get<std::uint64_t>();
+        gatesOffset              = header.get<std::uint64_t>();
+        const auto indicesOffset = header.get<std::uint64_t>();
+        annotationsOffset        = header.get<std::uint64_t>();
+
+        // the sections have to lie in order within the file and hold the declared number of elements
+        const auto indicesEnd = indicesOffset + (sizeof(std::uint32_t) * nIndices);
+        if (gatesOffset % 8U != 0U || gatesOffset < HEADER_SIZE || gatesOffset > size || gates > (size - std::min(gatesOffset, size)) / GATE_RECORD_SIZE ||
+            indicesOffset != gatesOffset + (GATE_RECORD_SIZE * gates) || nIndices > (size - std::min<std::uint64_t>(indicesOffset, size)) / sizeof(std::uint32_t) ||
+            ((flags & FLAG_ANNOTATIONS) != 0U) != (annotationsOffset != 0U) || (annotationsOffset != 0U && (annotationsOffset < indicesEnd || annotationsOffset > size))) {
+            throw std::runtime_error("Binary circuit file " + filename + " is corrupt");
+        }
+        nGates  = static_cast<std::size_t>(gates);
+        indices = reinterpret_cast<const std::uint32_t*>(data() + indicesOffset); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        Reader meta(data(), gatesOffset, HEADER_SIZE);
+        constants.reserve(lines);
+        garbage.reserve(lines);
+        for (unsigned l = 0U; l < lines; ++l) {
+            const auto c = meta.get<std::uint8_t>();
+            constants.emplace_back(c == NO_CONSTANT ? constant() : constant(c != 0U));
+            garbage.emplace_back(meta.get<std::uint8_t>() != 0U);
+        }
+        for (auto* names: {&inputs, &outputs}) {
+            names->reserve(lines);
+            for (unsigned l = 0U; l < lines; ++l) {
+                names->emplace_back(meta.getString());
+            }
+        }
+
+        // validate every gate once, such that gate() does not need to check anything
+        std::uint64_t expected = 0U;
+        for (std::size_t i = 0U; i < nGates; ++i) {
+            Reader     record(data(), size, gatesOffset + (GATE_RECORD_SIZE * i));
+            const auto first     = record.get<std::uint64_t>();
+            const auto nControls = record.get<std::uint32_t>();
+            const auto nTargets  = record.get<std::uint8_t>();
+            const auto type      = record.get<std::uint8_t>();
+            if (first != expected || !isValidGate(type, nTargets) || std::uint64_t{nControls} + nTargets > nIndices - first) {
+                throw std::runtime_error("Binary circuit file " + filename + " has a corrupt gate " + std::to_string(i));
+            }
+            expected += nControls + nTargets;
+        }
+        if (expected != nIndices) {
+            throw std::runtime_error("Binary circuit file " + filename + " is corrupt");
+        }
+        for (std::uint64_t i = 0U; i < nIndices; ++i) {
+            if (indices[i] >= lines) {
+                throw std::runtime_error("Binary circuit file " + filename + " has a gate on a line beyond " + std::to_string(lines));
+            }
+        }
+    }
+
+    MappedCircuit::GateView MappedCircuit::gate(const std::size_t i) const {
+        Reader     record(data(), region.get_size(), gatesOffset + (GATE_RECORD_SIZE * i));
+        const auto first     = record.get<std::uint64_t>();
+        const auto nControls = record.get<std::uint32_t>();
+        const auto nTargets  = record.get<std::uint8_t>();
+        const auto type      = record.get<std::uint8_t>();
+        const auto* controls = indices + first;
+        return {static_cast<Gate::Types>(type), LineRange(controls, controls + nControls), LineRange(controls + nControls, controls + nControls + nTargets)};
+    }
+
+    void MappedCircuit::load(Circuit& circ) const {
+        if (circ.numGates() != 0U) {
+            throw std::invalid_argument("Binary circuits can only be loaded into circuits without gates");
+        }
+
+        // the gates and annotations are collected in a separate circuit, such that a corrupt annotation leaves circ unchanged
+        Circuit            loaded;
+        std::vector<Gate*> loadedGates;
+        loadedGates.reserve(nGates);
+        for (std::size_t i = 0U; i < nGates; ++i) {
+            const auto g       = gate(i);
+            Gate&      newGate = loaded.appendGate();
+            newGate.controls.insert(g.controls().begin(), g.controls().end());
+            newGate.targets.insert(g.targets().begin(), g.targets().end());
+            newGate.type = g.type();
+            loadedGates.emplace_back(&newGate);
+        }
+
+        if (hasAnnotations()) {
+            Reader     reader(data(), region.get_size(), annotationsOffset);
+            const auto nAnnotations = reader.get<std::uint64_t>();
+            for (std::uint64_t i = 0U; i < nAnnotations; ++i) {
+                const auto gateIndex = reader.get<std::uint64_t>();
+                const auto kind      = reader.get<std::uint8_t>();
+                const auto key       = reader.getString();
+                if (gateIndex >= nGates || (kind != STRING_VALUE && kind != NUMBER_VALUE)) {
+                    throw std::runtime_error("Binary circuit file has a corrupt annotation");
+                }
+                if (kind == NUMBER_VALUE) {
+                    loaded.annotate(*loadedGates[gateIndex], key, static_cast<unsigned>(reader.get<std::uint32_t>()));
+                } else {
+                    loaded.annotate(*loadedGates[gateIndex], key, reader.getString());
+                }
+            }
+        }
+
+        circ.setLines(lines);
+        circ.setInputs(inputs);
+        circ.setOutputs(outputs);
+        circ.setConstants(constants);
+        circ.setGarbage(garbage);
+        circ.insertCircuit(0U, std::move(loaded), {});
+    }
+
+} // namespace syrec
@@ -0,0 +1,154 @@
+#include "core/io/cpp_writer.hpp"
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace syrec {
+
+    namespace {
+        bool isIdentifier(const std::string& name) {
+            if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front())) != 0) {
+                return false;
+            }
+            for (const auto c: name) {
+                if (std::isalnum(static_cast<unsigned char>(c)) == 0 && c != '_') {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // escapes line breaks, other control characters and backslashes, such that a name cannot end or continue a // comment
+        std::string commentText(const std::string& name) {
+            std::ostringstream escaped;
+            for (const auto c: name) {
+                const auto u = static_cast<unsigned char>(c);
+                if (std::iscntrl(u) != 0 || c == '\\') {
+                    escaped << "\\x" << "0123456789abcdef"[u >> 4U] << "0123456789abcdef"[u & 0xFU];
+                } else {
+                    escaped << c;
+                }
+            }
+            return escaped.str();
+        }
+
+        // conjunction of the control lines, empty for uncontrolled gates
+        std::string controlTerm(const Gate& g) {
+            std::string term;
+            for (const auto& control: g.controls) {
+                term += (term.empty() ? "l" : " & l") + std::to_string(control);
+            }
+            return term;
+        }
+
+        void writeGate(std::ostream& os, const Gate& g) {
+            const auto controls = controlTerm(g);
+            switch (g.type) {
+                case Gate::Types::Toffoli: {
+                    const auto target = *g.targets.begin();
+                    if (controls.empty()) {
+                        os << "    l" << target << " = ~l" << target << ";\n";
+                    } else {
+                        os << "    l" << target << " ^= " << controls << ";\n";
+                    }
+                    break;
+                }
+                case Gate::Types::Fredkin: {
+                    const auto target1 = *g.targets.begin();
+                    const auto target2 = *std::next(g.targets.begin());
+                    // masked swap: flip both targets where they differ and the controls are set
+                    os << "    {\n        const std::uint64_t d = ";
+                    if (controls.empty()) {
+                        os << "l" << target1 << " ^ l" << target2;
+                    } else {
+                        os << "(l" << target1 << " ^ l" << target2 << ") & " << controls;
+                    }
+                    os << ";\n        l" << target1 << " ^= d;\n        l" << target2 << " ^= d;\n    }\n";
+                    break;
+                }
+                // GCOVR_EXCL_START
+                default:
+                    throw std::runtime_error("Gate not supported");
+                    // GCOVR_EXCL_STOP
+            }
+        }
+    } // namespace
+
+    void writeCpp(std::ostream& os, const Circuit& circ, const std::string& functionName) {
+        if (!isIdentifier(functionName)) {
+            throw std::invalid_argument("'" + functionName + "' is not a valid function name");
+        }
+
+        const auto  nLines    = circ.getLines();
+        const auto& inputs    = circ.getInputs();
+        const auto& outputs   = circ.getOutputs();
+        const auto& constants = circ.getConstants();
+        const auto& garbage   = circ.getGarbage();
+
+        os << "#pragma once\n\n"
+           << "// Generated by mqt-syrec from a circuit with " << nLines << " lines and " << circ.numGates() << " gates.\n"
+           << "//\n"
+           << "// " << functionName << "(lines) applies the circuit to 64 bit-sliced patterns in place:\n"
+           << "// lines[l] holds line l of all patterns, bit k of every word belongs to pattern k.\n"
+           << "//\n"
+           << "// line: input -> output\n";
+        for (unsigned l = 0U; l < nLines; ++l) {
+            os << "// " << l << ": ";
+            if (l < constants.size() && constants[l]) {
+                os << "constant " << *constants[l];
+            } else {
+                os << (l < inputs.size() ? commentText(inputs[l]) : "");
+            }
+            os << " -> ";
+            if (l < garbage.size() && garbage[l]) {
+                os << "garbage";
+            } else {
+                os << (l < outputs.size() ? commentText(outputs[l]) : "");
+            }
+            os << "\n";
+        }
+        os << "\n"
+           << "#include <cstddef>\n"
+           << "#include <cstdint>\n\n"
+           << "inline constexpr std::size_t " << functionName << "_lines = " << nLines << "U;\n\n"
+           << "inline void " << functionName << "(std::uint64_t* lines) {\n";
+
+        for (unsigned l = 0U; l < nLines; ++l) {
+            os << "    std::uint64_t l" << l << " = lines[" << l << "];\n";
+        }
+
+        os << "\n";
+        circ.forEachGate([&os](const Gate& g) { writeGate(os, g); });
+        os << "\n";
+
+        for (unsigned l = 0U; l < nLines; ++l) {
+            os << "    lines[" << l << "] = l" << l << ";\n";
+        }
+        os << "}\n";
+    }
+
+    std::string toCpp(const Circuit& circ, const std::string& functionName) {
+        std::stringstream ss;
+        writeCpp(ss, circ, functionName);
+        return ss.str();
+    }
+
+    bool toCppFile(const Circuit& circ, const std::string& filename, const std::string& functionName) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            return false; // GCOVR_EXCL_LINE
+        }
+        writeCpp(file, circ, functionName);
+        file.close();
+        return true;
+    }
+
+} // namespace syrec
@@ -0,0 +1,292 @@
+#include "core/io/real_reader.hpp"
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        bool isSpace(const char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        // splits a line at whitespace, names enclosed in quotes may contain whitespace and are returned without quotes
+        void tokenize(const std::string_view line, std::vector<std::string_view>& tokens) {
+            tokens.clear();
+            std::size_t i = 0U;
+            while (i < line.size()) {
+                while (i < line.size() && isSpace(line[i])) {
+                    ++i;
+                }
+                if (i == line.size()) {
+                    break;
+                }
+                if (line[i] == '"') {
+                    const auto end = line.find('"', i + 1U);
+                    if (end == std::string_view::npos) {
+                        throw std::runtime_error("missing closing quote");
+                    }
+                    tokens.emplace_back(line.substr(i + 1U, end - i - 1U));
+                    i = end + 1U;
+                } else {
+                    const auto start = i;
+                    while (i < line.size() && !isSpace(line[i])) {
+                        ++i;
+                    }
+                    tokens.emplace_back(line.substr(start, i - start));
+                }
+            }
+        }
+
+        std::string lower(std::string_view s) {
+            std::string l(s);
+            std::transform(l.begin(), l.end(), l.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return l;
+        }
+
+        std::optional<unsigned> toNumber(const std::string_view s) {
+            unsigned   n{};
+            const auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), n);
+            if (s.empty() || ec != std::errc() || end != s.data() + s.size()) {
+                return std::nullopt;
+            }
+            return n;
+        }
+
+        class RealReader {
+        public:
+            explicit RealReader(Circuit& circ):
+                circ(circ) {}
+
+            void readLine(const std::string_view line) {
+                const auto first = line.find_first_not_of(" \t\r");
+                if (first == std::string_view::npos || line[first] == '#') {
+                    return;
+                }
+                tokenize(line, tokens);
+                if (inBody) {
+                    readGate();
+                } else if (!ended) {
+                    readHeader();
+                }
+            }
+
+            void finish() const {
+                if (!inBody && !ended) {
+                    throw std::runtime_error("missing .begin");
+                }
+                if (!ended) {
+                    throw std::runtime_error("missing .end");
+                }
+            }
+
+            void setLineNumber(const std::size_t n) {
+                lineNumber = n;
+            }
+
+            [[nodiscard]] std::size_t getLineNumber() const {
+                return lineNumber;
+            }
+
+        private:
+            void readHeader() {
+                const auto command = lower(tokens.front());
+                if (command == ".numvars") {
+                    const auto n = tokens.size() == 2U ? toNumber(tokens[1]) : std::nullopt;
+                    if (!n) {
+                        throw std::runtime_error("invalid .numvars");
+                    }
+                    numVars = *n;
+                } else if (command == ".variables") {
+                    if (!numVars || tokens.size() - 1U != *numVars) {
+                        throw std::runtime_error(".variables must declare .numvars variables");
+                    }
+                    variables.clear();
+                    for (std::size_t i = 1U; i < tokens.size(); ++i) {
+                        if (!variables.try_emplace(std::string(tokens[i]), static_cast<Gate::line>(i - 1U)).second) {
+                            throw std::runtime_error("duplicate variable " + std::string(tokens[i]));
+                        }
+                    }
+                    // the input and output names default to the variable names
+                    circ.setLines(*numVars);
+                    const std::vector<std::string> names(tokens.begin() + 1, tokens.end());
+                    circ.setInputs(names);
+                    circ.setOutputs(names);
+                } else if (command == ".inputs" || command == ".outputs") {
+                    requireVariables(command);
+                    if (tokens.size() - 1U != circ.getLines()) {
+                        throw std::runtime_error(command + " must declare a name for every variable");
+                    }
+                    const std::vector<std::string> names(tokens.begin() + 1, tokens.end());
+                    if (command == ".inputs") {
+                        circ.setInputs(names);
+                    } else {
+                        circ.setOutputs(names);
+                    }
+                } else if (command == ".constants") {
+                    requireVariables(command);
+                    const auto values = flags(command);
+                    std::vector<constant> constants;
+                    constants.reserve(values.size());
+                    for (const auto c: values) {
+                        if (c != '-' && c != '0' && c != '1') {
+                            throw std::runtime_error("invalid value in .constants");
+                        }
+                        constants.emplace_back(c == '-' ? constant() : constant(c == '1'));
+                    }
+                    circ.setConstants(constants);
+                } else if (command == ".garbage") {
+                    requireVariables(command);
+                    const auto values = flags(command);
+                    std::vector<bool> garbage;
+                    garbage.reserve(values.size());
+                    for (const auto c: values) {
+                        if (c != '-' && c != '1') {
+                            throw std::runtime_error("invalid value in .garbage");
+                        }
+                        garbage.emplace_back(c == '1');
+                    }
+                    circ.setGarbage(garbage);
+                } else if (command == ".begin") {
+                    requireVariables(command);
+                    inBody = true;
+                } else if (command == ".end") {
+                    throw std::runtime_error(".end before .begin");
+                } else if (command.empty() || command.front() != '.') {
+                    throw std::runtime_error("gate before .begin");
+                }
+                // other headers like .version, .inputbus, or .state do not affect the circuit
+            }
+
+            void readGate() {
+                const auto name = lower(tokens.front());
+                if (name == ".end") {
+                    inBody = false;
+                    ended  = true;
+                    return;
+                }
+
+                Gate::Types type{};
+                std::size_t nTargets{};
+                switch (name.empty() ? '\0' : name.front()) {
+                    case 't':
+                        type     = Gate::Types::Toffoli;
+                        nTargets = 1U;
+                        break;
+                    case 'f':
+                        type     = Gate::Types::Fredkin;
+                        nTargets = 2U;
+                        break;
+                    default:
+                        throw std::runtime_error("unsupported gate " + std::string(tokens.front()));
+                }
+                const auto nLines = tokens.size() - 1U;
+                if (name.size() > 1U) {
+                    const auto declared = toNumber(std::string_view(name).substr(1U));
+                    if (!declared) {
+                        throw std::runtime_error("unsupported gate " + std::string(tokens.front()));
+                    }
+                    if (*declared != nLines) {
+                        throw std::runtime_error("gate " + std::string(tokens.front()) + " acts on " + std::to_string(nLines) + " lines");
+                    }
+                }
+                if (nLines < nTargets) {
+                    throw std::runtime_error("gate " + std::string(tokens.front()) + " needs at least " + std::to_string(nTargets) + " lines");
+                }
+
+                Gate& g = circ.appendGate();
+                g.type  = type;
+                for (std::size_t i = 1U; i < tokens.size(); ++i) {
+                    const auto l = lineOf(tokens[i]);
+                    if (g.controls.count(l) != 0U || g.targets.count(l) != 0U) {
+                        throw std::runtime_error("gate acts twice on " + std::string(tokens[i]));
+                    }
+                    if (i + nTargets < tokens.size()) {
+                        g.controls.insert(l);
+                    } else {
+                        g.targets.insert(l);
+                    }
+                }
+            }
+
+            Gate::line lineOf(const std::string_view variable) {
+                lookup.assign(variable);
+                const auto it = variables.find(lookup);
+                if (it == variables.end()) {
+                    if (!variable.empty() && variable.front() == '-') {
+                        throw std::runtime_error("negative control " + lookup + " is not supported");
+                    }
+                    throw std::runtime_error("unknown variable " + lookup);
+                }
+                return it->second;
+            }
+
+            void requireVariables(const std::string& command) const {
+                if (variables.empty() && numVars.value_or(1U) != 0U) {
+                    throw std::runtime_error(command + " before .variables");
+                }
+            }
+
+            // single token with one character per line
+            std::string_view flags(const std::string& command) const {
+                const auto values = tokens.size() == 2U ? tokens[1] : std::string_view();
+                if (tokens.size() > 2U || values.size() != circ.getLines()) {
+                    throw std::runtime_error(command + " must declare a value for every variable");
+                }
+                return values;
+            }
+
+            Circuit&                                    circ;
+            std::vector<std::string_view>               tokens;
+            std::unordered_map<std::string, Gate::line> variables;
+            std::string                                 lookup;
+            std::optional<unsigned>                     numVars;
+            bool                                        inBody     = false;
+            bool                                        ended      = false;
+            std::size_t                                 lineNumber = 0U;
+        };
+    } // namespace
+
+    void parseReal(Circuit& circ, std::istream& is) {
+        if (circ.numGates() != 0U) {
+            throw std::invalid_argument(".real files can only be read into circuits without gates");
+        }
+        RealReader  reader(circ);
+        std::string line;
+        try {
+            while (std::getline(is, line)) {
+                reader.setLineNumber(reader.getLineNumber() + 1U);
+                reader.readLine(line);
+            }
+            reader.finish();
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Invalid .real file, line " + std::to_string(reader.getLineNumber()) + ": " + e.what());
+        }
+    }
+
+    bool readReal(Circuit& circ, const std::string& filename) {
+        std::ifstream is(filename);
+        if (!is.good()) {
+            std::cerr << "Cannot open " + filename << '\n';
+            return false;
+        }
+        parseReal(circ, is);
+        return true;
+    }
+
+} // namespace syrec
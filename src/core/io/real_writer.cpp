@@ -0,0 +1,128 @@
+#include "core/io/real_writer.hpp"
+
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+#include "core/utils/chunked_writer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace syrec {
+
+    namespace {
+        bool isIoName(const std::string& name) {
+            return !name.empty() && std::all_of(name.cbegin(), name.cend(), [](const char c) { return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_'; });
+        }
+
+        void writeIoNames(std::ostream& os, const char* header, const std::vector<std::string>& names, const unsigned nLines) {
+            os << header;
+            for (unsigned l = 0U; l < nLines; ++l) {
+                const auto& name = l < names.size() ? names[l] : std::string();
+                if (isIoName(name)) {
+                    os << ' ' << name;
+                } else {
+                    os << " \"" << name << '"';
+                }
+            }
+            os << '\n';
+        }
+
+        void appendVariable(std::string& out, const Gate::line l) {
+            out += " x";
+            Gate::appendLine(out, l);
+        }
+
+        void appendGate(std::string& out, const Gate& g) {
+            switch (g.type) {
+                case Gate::Types::Toffoli:
+                    out += 't';
+                    break;
+                case Gate::Types::Fredkin:
+                    out += 'f';
+                    break;
+                // GCOVR_EXCL_START
+                default:
+                    throw std::runtime_error("Gate not supported");
+                    // GCOVR_EXCL_STOP
+            }
+            Gate::appendLine(out, g.controls.size() + g.targets.size());
+            for (const auto& control: g.controls) {
+                appendVariable(out, control);
+            }
+            for (const auto& target: g.targets) {
+                appendVariable(out, target);
+            }
+            out += '\n';
+        }
+    } // namespace
+
+    void writeReal(std::ostream& os, const Circuit& circ, const unsigned nThreads) {
+        const auto  nLines    = circ.getLines();
+        const auto& constants = circ.getConstants();
+        const auto& garbage   = circ.getGarbage();
+
+        os << ".version 2.0\n"
+           << ".numvars " << nLines << "\n"
+           << ".variables";
+        for (unsigned l = 0U; l < nLines; ++l) {
+            os << " x" << l;
+        }
+        os << "\n";
+        writeIoNames(os, ".inputs", circ.getInputs(), nLines);
+        writeIoNames(os, ".outputs", circ.getOutputs(), nLines);
+
+        os << ".constants ";
+        for (unsigned l = 0U; l < nLines; ++l) {
+            if (l < constants.size() && constants[l]) {
+                os << (*constants[l] ? '1' : '0');
+            } else {
+                os << '-';
+            }
+        }
+        os << "\n.garbage ";
+        for (unsigned l = 0U; l < nLines; ++l) {
+            os << (l < garbage.size() && garbage[l] ? '1' : '-');
+        }
+        os << "\n.begin\n";
+
+        if (circ.getInstances().empty()) {
+            writeChunked(os, circ.cbegin(), circ.cend(), nThreads, [](std::string& buffer, const Gate* g) { appendGate(buffer, *g); });
+        } else {
+            std::string buffer;
+            circ.forEachGate([&os, &buffer](const Gate& g) {
+                appendGate(buffer, g);
+                if (buffer.size() >= (1U << 16U)) {
+                    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            });
+            os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+
+        os << ".end\n";
+    }
+
+    std::string toReal(const Circuit& circ) {
+        std::stringstream ss;
+        writeReal(ss, circ);
+        return ss.str();
+    }
+
+    bool toRealFile(const Circuit& circ, const std::string& filename, const unsigned nThreads) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            return false; // GCOVR_EXCL_LINE
+        }
+        writeReal(file, circ, nThreads);
+        file.close();
+        return true;
+    }
+
+} // namespace syrec
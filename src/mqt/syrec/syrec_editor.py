@@ -299,9 +299,11 @@ class SyReCEditor(QtWidgets.QWidget):  # type: ignore[misc]
 
         tc = self.circ.transistor_cost()
 
-        temp = "Gates:\t\t{}\nLines:\t\t{}\nQuantum Costs:\t{}\nTransistor Costs:\t{}\n"
+        depth = self.circ.depth()
 
-        output = temp.format(gates, lines, qc, tc)
+        temp = "Gates:\t\t{}\nLines:\t\t{}\nDepth:\t\t{}\nQuantum Costs:\t{}\nTransistor Costs:\t{}\n"
+
+        output = temp.format(gates, lines, depth, qc, tc)
 
         msg = QtWidgets.QMessageBox()
         msg.setBaseSize(QtCore.QSize(300, 200))
@@ -1,19 +1,53 @@
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
 #include "algorithms/simulation/simple_simulation.hpp"
 #include "algorithms/synthesis/syrec_cost_aware_synthesis.hpp"
 #include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
 #include "core/circuit.hpp"
 #include "core/gate.hpp"
+#include "core/io/binary_circuit.hpp"
+#include "core/io/real_reader.hpp"
+#include "core/io/real_writer.hpp"
 #include "core/properties.hpp"
 #include "core/syrec/program.hpp"
 
 #include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace py = pybind11;
 using namespace pybind11::literals;
 using namespace syrec;
 
+namespace {
+    // simulates the rows of a 2-D array of packed patterns into a preallocated array of the same shape
+    template<typename Word>
+    void batchSimulation(py::array_t<Word, py::array::c_style> outputs, const Circuit& circ, const py::array_t<Word, py::array::c_style>& inputs, const Properties::ptr& statistics) {
+        if (inputs.ndim() != 2 || outputs.ndim() != 2 || inputs.shape(0) != outputs.shape(0) || inputs.shape(1) != outputs.shape(1)) {
+            throw std::invalid_argument("inputs and outputs must be 2-D arrays of the same shape");
+        }
+        const auto stride = static_cast<std::size_t>(inputs.shape(1));
+        if (stride * sizeof(Word) * 8U < circ.getLines()) {
+            throw std::invalid_argument("rows must hold at least as many bits as the circuit has lines");
+        }
+
+        const CompiledCircuit compiled(circ);
+        Word*                 out = outputs.mutable_data();
+        const Word*           in  = inputs.data();
+
+        const py::gil_scoped_release release;
+        bitParallelSimulation(out, in, static_cast<std::size_t>(inputs.shape(0)), stride, compiled, statistics);
+    }
+} // namespace
+
 PYBIND11_MODULE(pysyrec, m) {
     m.doc() = "Python interface for the SyReC programming language for the synthesis of reversible circuits";
 
@@ -22,7 +56,7 @@ PYBIND11_MODULE(pysyrec, m) {
             .def_property("lines", &syrec::Circuit::getLines, &syrec::Circuit::setLines, "Returns the number of circuit lines.")
             .def_property_readonly("num_gates", &syrec::Circuit::numGates, "Returns the total number of gates in the circuit.")
             .def("__iter__",
-                 [](Circuit& circ) { return py::make_iterator(circ.begin(), circ.end()); })
+                 [](Circuit& circ) { return py::make_iterator(circ.begin(), circ.end()); }, py::keep_alive<0, 1>())
             .def_property("inputs", &syrec::Circuit::getInputs, &syrec::Circuit::setInputs, "Returns the input names of the lines in a circuit.")
             .def_property("outputs", &syrec::Circuit::getOutputs, &syrec::Circuit::setOutputs, "Returns the output names of the lines in a circuit.")
             .def_property("constants", &syrec::Circuit::getConstants, &syrec::Circuit::setConstants, "Returns the constant input line specification.")
@@ -41,8 +75,64 @@ PYBIND11_MODULE(pysyrec, m) {
                     "This method returns all annotations for a given gate.")
             .def("quantum_cost", &syrec::Circuit::quantumCost, "Returns the quantum cost of the circuit.")
             .def("transistor_cost", &syrec::Circuit::transistorCost, "Returns the transistor cost of the circuit.")
-            .def("to_qasm_str", &syrec::Circuit::toQasm, "Returns the QASM representation of the circuit.")
-            .def("to_qasm_file", &syrec::Circuit::toQasmFile, "filename"_a, "Writes the QASM representation of the circuit to a file.");
+            .def("depth", &syrec::Circuit::depth, "Returns the depth of the circuit.")
+            .def(
+                    "gate_histogram", [](const Circuit& c) { return c.getMetrics().gateHistogram(); },
+                    "Returns the number of gates for every combination of gate type and number of controls.")
+            .def("recompute_metrics", &syrec::Circuit::recomputeMetrics, "num_threads"_a = 0U,
+                 "Recounts the cost, depth, and gate histogram of the circuit. Necessary after modifying gates of the circuit in place.")
+            .def(
+                    "append_instance", [](Circuit& c, const std::shared_ptr<Circuit>& sub, const std::vector<std::size_t>& lines, const bool inverted) { c.appendInstance(sub, lines, inverted); },
+                    "sub"_a, "lines"_a, "inverted"_a = false,
+                    "Appends an instance of a shared sub-circuit, mapping line i of the sub-circuit to lines[i]. Inverted instances apply the gates in reverse order.")
+            .def_property_readonly(
+                    "num_instances", [](const Circuit& c) { return c.getInstances().size(); }, "Returns the number of instances which have not been expanded.")
+            .def("flatten", &syrec::Circuit::flatten, "Replaces all instances by copies of their gates.")
+            .def(
+                    "gates_on_line", [](const Circuit& c, const unsigned l) {
+                        const auto gates = c.getDependencies().gatesOn(l);
+                        return std::vector<std::size_t>(gates.begin(), gates.end());
+                    },
+                    "line"_a, "Returns the positions of the gates acting on the given line.")
+            .def(
+                    "predecessors", [](const Circuit& c, const std::size_t pos) {
+                        const auto predecessors = c.getDependencies().predecessorsOf(pos);
+                        return std::vector<std::size_t>(predecessors.begin(), predecessors.end());
+                    },
+                    "pos"_a, "Returns the positions of the gates the gate at the given position directly depends on.")
+            .def(
+                    "successors", [](const Circuit& c, const std::size_t pos) { return c.getDependencies().successorsOf(pos); },
+                    "pos"_a, "Returns the positions of the gates directly depending on the gate at the given position.")
+            .def(
+                    "asap_layers", [](const Circuit& c) {
+                        const auto&              dependencies = c.getDependencies();
+                        std::vector<std::size_t> layers(dependencies.numGates());
+                        for (std::size_t i = 0U; i < layers.size(); ++i) {
+                            layers[i] = dependencies.asap(i);
+                        }
+                        return layers;
+                    },
+                    "Returns the earliest layer of every gate.")
+            .def(
+                    "alap_layers", [](const Circuit& c) {
+                        const auto&              dependencies = c.getDependencies();
+                        std::vector<std::size_t> layers(dependencies.numGates());
+                        for (std::size_t i = 0U; i < layers.size(); ++i) {
+                            layers[i] = dependencies.alap(i);
+                        }
+                        return layers;
+                    },
+                    "Returns the latest layer of every gate that does not increase the depth.")
+            .def("rebuild_dependencies", &syrec::Circuit::rebuildDependencies, "Rebuilds the gate dependencies. Necessary after modifying gates of the circuit in place.")
+            .def("to_qasm_str", py::overload_cast<>(&syrec::Circuit::toQasm, py::const_), "Returns the QASM representation of the circuit.")
+            .def("to_qasm_file", &syrec::Circuit::toQasmFile, "filename"_a, "num_threads"_a = 1U, "Writes the QASM representation of the circuit to a file.")
+            .def("to_real_str", [](const Circuit& c) { return toReal(c); }, "Returns the RevLib .real representation of the circuit.")
+            .def("to_real_file", &toRealFile, "filename"_a, "num_threads"_a = 1U, "Writes the RevLib .real representation of the circuit to a file.")
+            .def("read_real_file", &readReal, "filename"_a, "Reads a RevLib .real file into a circuit without gates.")
+            .def("to_binary_file", &toBinaryFile, "filename"_a, "annotations"_a = true, "Writes the circuit to a file in the binary circuit format.")
+            .def(
+                    "read_binary_file", [](Circuit& c, const std::string& filename) { MappedCircuit(filename).load(c); }, "filename"_a,
+                    "Reads a file in the binary circuit format into a circuit without gates.");
 
     py::class_<Properties, std::shared_ptr<Properties>>(m, "properties")
             .def(py::init<>(), "Constructs property map object.")
@@ -84,11 +174,17 @@ PYBIND11_MODULE(pysyrec, m) {
 
     py::class_<Gate, std::shared_ptr<Gate>>(m, "gate")
             .def(py::init<>(), "Constructs gate object.")
-            .def_readwrite("controls", &Gate::controls, "Controls of the gate.")
-            .def_readwrite("targets", &Gate::targets, "Targets of the gate.")
+            .def_property(
+                    "controls", [](const Gate& g) { return std::set<Gate::line>(g.controls.begin(), g.controls.end()); },
+                    [](Gate& g, const std::set<Gate::line>& controls) { g.controls = Gate::line_container(controls.begin(), controls.end()); }, "Controls of the gate.")
+            .def_property(
+                    "targets", [](const Gate& g) { return std::set<Gate::line>(g.targets.begin(), g.targets.end()); },
+                    [](Gate& g, const std::set<Gate::line>& targets) { g.targets = Gate::line_container(targets.begin(), targets.end()); }, "Targets of the gate.")
             .def_readwrite("type", &Gate::type, "Type of the gate.");
 
     m.def("cost_aware_synthesis", &CostAwareSynthesis::synthesize, "circ"_a, "program"_a, "settings"_a = Properties::ptr(), "statistics"_a = Properties::ptr(), "Cost-aware synthesis of the SyReC program.");
     m.def("line_aware_synthesis", &LineAwareSynthesis::synthesize, "circ"_a, "program"_a, "settings"_a = Properties::ptr(), "statistics"_a = Properties::ptr(), "Line-aware synthesis of the SyReC program.");
-    m.def("simple_simulation", &simpleSimulation, "output"_a, "circ"_a, "input"_a, "statistics"_a = Properties::ptr(), "Simulation of the synthesized circuit circ.");
+    m.def("simple_simulation", py::overload_cast<boost::dynamic_bitset<>&, const Circuit&, const boost::dynamic_bitset<>&, const Properties::ptr&>(&simpleSimulation), "output"_a, "circ"_a, "input"_a, "statistics"_a = Properties::ptr(), "Simulation of the synthesized circuit circ.");
+    m.def("batch_simulation", &batchSimulation<std::uint8_t>, "outputs"_a.noconvert(), "circ"_a, "inputs"_a.noconvert(), "statistics"_a = Properties::ptr(), "Bit-parallel simulation of the rows of a 2-D uint8 array of packed patterns into a preallocated array of the same shape. Bit l % 8 of byte l / 8 of a row holds line l.");
+    m.def("batch_simulation", &batchSimulation<std::uint64_t>, "outputs"_a.noconvert(), "circ"_a, "inputs"_a.noconvert(), "statistics"_a = Properties::ptr(), "Bit-parallel simulation of the rows of a 2-D uint64 array of packed patterns into a preallocated array of the same shape. Bit l % 64 of word l / 64 of a row holds line l.");
 }
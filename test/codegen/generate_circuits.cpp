@@ -0,0 +1,65 @@
+// Synthesizes test circuits and emits them as C++ headers, which are compiled into mqt-syrec-test
+// to check the generated code against the simulation of the circuits.
+//
+// Usage: mqt-syrec-test-codegen <circuits directory> <output directory> <circuit>...
+
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/io/cpp_writer.hpp"
+#include "core/syrec/program.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <circuits directory> <output directory> <circuit>...\n";
+        return 1;
+    }
+    const std::string              circuitsDir = argv[1];
+    const std::string              outputDir   = argv[2];
+    const std::vector<std::string> names(argv + 3, argv + argc);
+
+    std::ofstream registry(outputDir + "/generated_circuits.hpp");
+    registry << "#pragma once\n\n";
+    for (const auto& name: names) {
+        registry << "#include \"" << name << ".hpp\"\n";
+    }
+    registry << "\n#include <cstddef>\n#include <cstdint>\n#include <string_view>\n\n"
+             << "struct GeneratedCircuit {\n"
+             << "    std::string_view name;\n"
+             << "    std::size_t      lines;\n"
+             << "    void (*simulate)(std::uint64_t*);\n"
+             << "};\n\n"
+             << "inline constexpr GeneratedCircuit generatedCircuits[] = {\n";
+
+    for (const auto& name: names) {
+        Program             prog;
+        ReadProgramSettings settings;
+        const auto          errorString = prog.read(circuitsDir + "/" + name + ".src", settings);
+        if (!errorString.empty()) {
+            std::cerr << name << ": " << errorString << "\n";
+            return 1;
+        }
+
+        Circuit circ;
+        if (!LineAwareSynthesis::synthesize(circ, prog)) {
+            std::cerr << name << ": synthesis failed\n";
+            return 1;
+        }
+
+        const auto functionName = "generated_" + name;
+        if (!toCppFile(circ, outputDir + "/" + name + ".hpp", functionName)) {
+            std::cerr << name << ": cannot write " << outputDir << "/" << name << ".hpp\n";
+            return 1;
+        }
+        registry << "    {\"" << name << "\", " << functionName << "_lines, &" << functionName << "},\n";
+    }
+    registry << "};\n";
+
+    return registry.good() ? 0 : 1;
+}
@@ -4,6 +4,7 @@ import json
 from pathlib import Path
 from typing import Any
 
+import numpy as np
 import pytest
 
 from mqt import syrec
@@ -113,9 +114,186 @@ def test_simulation_add_lines(data_cost_aware_simulation: dict[str, Any]) -> Non
         assert data_cost_aware_simulation[file_name]["sim_out"] == str(my_out_bitset)
 
 
-def test_no_lines_to_qasm(data_line_aware_synthesis: dict[str, Any]) -> None:
+def test_batch_simulation(data_line_aware_simulation: dict[str, Any]) -> None:
+    rng = np.random.default_rng(42)
+    for file_name in data_line_aware_simulation:
+        circ = syrec.circuit()
+        prog = syrec.program()
+        error = prog.read(str(circuit_dir / (file_name + ".src")))
+
+        assert not error
+        assert syrec.line_aware_synthesis(circ, prog)
+
+        for dtype, bits in ((np.uint8, 8), (np.uint64, 64)):
+            words = (circ.lines + bits - 1) // bits
+            inputs = rng.integers(0, np.iinfo(dtype).max, size=(100, words), dtype=dtype, endpoint=True)
+            # clear the bits beyond the last line
+            bit_matrix = np.unpackbits(inputs.view(np.uint8), axis=1, bitorder="little")
+            bit_matrix[:, circ.lines :] = 0
+            inputs = np.packbits(bit_matrix, axis=1, bitorder="little").view(dtype)
+            outputs = np.empty_like(inputs)
+
+            syrec.batch_simulation(outputs, circ, inputs)
+
+            for row in range(inputs.shape[0]):
+                my_inp_bitset = syrec.bitset(circ.lines)
+                my_out_bitset = syrec.bitset(circ.lines)
+                for line in np.flatnonzero(bit_matrix[row, : circ.lines]):
+                    my_inp_bitset.set(int(line), True)
+
+                syrec.simple_simulation(my_out_bitset, circ, my_inp_bitset)
+                out_bits = np.unpackbits(outputs[row : row + 1].view(np.uint8), axis=1, bitorder="little")[0, : circ.lines]
+                assert str(my_out_bitset) == "".join(str(b) for b in out_bits)
+
+
+def test_batch_simulation_shape_mismatch() -> None:
+    circ = syrec.circuit()
+    circ.lines = 3
+    with pytest.raises(ValueError, match="same shape"):
+        syrec.batch_simulation(np.zeros((2, 1), dtype=np.uint8), circ, np.zeros((3, 1), dtype=np.uint8))
+
+
+def test_no_lines_to_qasm(data_line_aware_synthesis: dict[str, Any], tmp_path: Path) -> None:
+    for file_name in data_line_aware_synthesis:
+        circ = syrec.circuit()
+        prog = syrec.program()
+        prog.read(str(circuit_dir / (file_name + ".src")))
+        assert circ.to_qasm_file(str(tmp_path / (file_name + ".qasm")))
+
+
+def test_to_real(data_line_aware_synthesis: dict[str, Any], tmp_path: Path) -> None:
     for file_name in data_line_aware_synthesis:
         circ = syrec.circuit()
         prog = syrec.program()
         prog.read(str(circuit_dir / (file_name + ".src")))
-        assert circ.to_qasm_file(str(circuit_dir / (file_name + ".qasm")))
+        assert syrec.line_aware_synthesis(circ, prog)
+
+        real = circ.to_real_str()
+        assert real.startswith(".version 2.0\n")
+        assert real.count("\n") == circ.num_gates + 9
+        assert circ.to_real_file(str(tmp_path / (file_name + ".real")), num_threads=2)
+        assert (tmp_path / (file_name + ".real")).read_text() == real
+
+
+def test_gate_iteration(data_line_aware_synthesis: dict[str, Any]) -> None:
+    for file_name in data_line_aware_synthesis:
+        circ = syrec.circuit()
+        prog = syrec.program()
+        error = prog.read(str(circuit_dir / (file_name + ".src")))
+
+        assert not error
+        assert syrec.line_aware_synthesis(circ, prog)
+
+        gates = list(circ)
+        assert len(gates) == circ.num_gates
+        for gate in gates:
+            assert gate.type in {syrec.gate_type.toffoli, syrec.gate_type.fredkin}
+            assert "lno" in circ.annotations(gate)
+
+
+def test_foreign_gate_annotations(data_line_aware_synthesis: dict[str, Any]) -> None:
+    circ = syrec.circuit()
+    assert circ.annotations(syrec.gate()) == {}
+
+    for file_name in data_line_aware_synthesis:
+        prog = syrec.program()
+        error = prog.read(str(circuit_dir / (file_name + ".src")))
+
+        assert not error
+        assert syrec.line_aware_synthesis(circ, prog)
+        assert circ.annotations(syrec.gate()) == {}
+        break
+
+
+def test_metrics(data_line_aware_synthesis: dict[str, Any]) -> None:
+    for file_name in data_line_aware_synthesis:
+        circ = syrec.circuit()
+        prog = syrec.program()
+        error = prog.read(str(circuit_dir / (file_name + ".src")))
+
+        assert not error
+        assert syrec.line_aware_synthesis(circ, prog)
+
+        histogram = circ.gate_histogram()
+        assert sum(histogram.values()) == circ.num_gates
+        assert sum(8 * controls * n for (_, controls), n in histogram.items()) == circ.transistor_cost()
+        assert 0 < circ.depth() <= circ.num_gates
+
+        # in-place modifications are only reflected after recounting
+        gate = next(iter(circ))
+        removed = len(gate.controls)
+        gate.controls = set()
+        circ.recompute_metrics(num_threads=2)
+        assert circ.transistor_cost() == data_line_aware_synthesis[file_name]["transistor_costs"] - 8 * removed
+
+
+def test_dependencies(data_line_aware_synthesis: dict[str, Any]) -> None:
+    for file_name in data_line_aware_synthesis:
+        circ = syrec.circuit()
+        prog = syrec.program()
+        error = prog.read(str(circuit_dir / (file_name + ".src")))
+
+        assert not error
+        assert syrec.line_aware_synthesis(circ, prog)
+
+        asap = circ.asap_layers()
+        alap = circ.alap_layers()
+        assert len(asap) == len(alap) == circ.num_gates
+        assert max(asap, default=-1) + 1 == circ.depth()
+        assert all(a <= b for a, b in zip(asap, alap))
+        assert sum(len(circ.gates_on_line(line)) for line in range(circ.lines)) == sum(len(gate.controls) + len(gate.targets) for gate in circ)
+        for pos in range(circ.num_gates):
+            assert all(asap[p] < asap[pos] for p in circ.predecessors(pos))
+            assert all(alap[s] > alap[pos] for s in circ.successors(pos))
+
+
+def test_instances(data_line_aware_synthesis: dict[str, Any]) -> None:
+    for file_name in data_line_aware_synthesis:
+        sub = syrec.circuit()
+        prog = syrec.program()
+        prog.read(str(circuit_dir / (file_name + ".src")))
+        assert syrec.line_aware_synthesis(sub, prog)
+
+        # a circuit followed by its inverse is the identity
+        circ = syrec.circuit()
+        circ.lines = sub.lines
+        circ.append_instance(sub, list(range(sub.lines)))
+        circ.append_instance(sub, list(range(sub.lines)), inverted=True)
+        assert circ.num_instances == 2
+        assert circ.num_gates == 2 * sub.num_gates
+        assert circ.transistor_cost() == 2 * sub.transistor_cost()
+
+        inp = syrec.bitset(circ.lines, 0b1011)
+        out = syrec.bitset(circ.lines)
+        syrec.simple_simulation(out, circ, inp)
+        assert str(out) == str(inp)
+        qasm = circ.to_qasm_str()
+        assert circ.num_instances == 2
+
+        circ.flatten()
+        assert circ.num_instances == 0
+        assert circ.num_gates == 2 * sub.num_gates
+        assert circ.to_qasm_str() == qasm
+
+        with pytest.raises(ValueError, match="mapping"):
+            circ.append_instance(sub, [0])
+
+
+def test_binary_file(data_line_aware_synthesis: dict[str, Any], tmp_path: Path) -> None:
+    for file_name in data_line_aware_synthesis:
+        circ = syrec.circuit()
+        prog = syrec.program()
+        prog.read(str(circuit_dir / (file_name + ".src")))
+        assert syrec.line_aware_synthesis(circ, prog)
+        assert circ.to_binary_file(str(tmp_path / (file_name + ".bin")))
+
+        loaded = syrec.circuit()
+        loaded.read_binary_file(str(tmp_path / (file_name + ".bin")))
+        assert loaded.to_qasm_str() == circ.to_qasm_str()
+        assert loaded.inputs == circ.inputs
+        assert loaded.garbage == circ.garbage
+        for gate, loaded_gate in zip(circ, loaded):
+            assert loaded.annotations(loaded_gate) == circ.annotations(gate)
+
+        with pytest.raises(ValueError, match="without gates"):
+            loaded.read_binary_file(str(tmp_path / (file_name + ".bin")))
@@ -0,0 +1,224 @@
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/io/binary_circuit.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace syrec;
+
+class SyrecBinaryCircuitTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+    std::string binaryFileName;
+
+    void SetUp() override {
+        fileName       = testCircuitsDir + GetParam() + ".src";
+        binaryFileName = testing::TempDir() + GetParam() + ".bin";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecBinaryCircuitTest, SyrecBinaryCircuitTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "binary_numeric",
+                                 "call_8",
+                                 "for_4",
+                                 "negate_8",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecBinaryCircuitTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecBinaryCircuitTest, GenericBinaryCircuitTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+    ASSERT_TRUE(toBinaryFile(circ, binaryFileName));
+
+    const MappedCircuit mapped(binaryFileName);
+    ASSERT_EQ(mapped.getLines(), circ.getLines());
+    ASSERT_EQ(mapped.numGates(), circ.numGates());
+    EXPECT_EQ(mapped.getInputs(), circ.getInputs());
+    EXPECT_EQ(mapped.getOutputs(), circ.getOutputs());
+    EXPECT_EQ(mapped.getConstants(), circ.getConstants());
+    EXPECT_EQ(mapped.getGarbage(), circ.getGarbage());
+    EXPECT_TRUE(mapped.hasAnnotations());
+
+    std::size_t i = 0U;
+    for (const auto& g: circ) {
+        const auto view = mapped.gate(i++);
+        EXPECT_EQ(view.type(), g->type);
+        EXPECT_TRUE(std::equal(view.controls().begin(), view.controls().end(), g->controls.begin(), g->controls.end()));
+        EXPECT_TRUE(std::equal(view.targets().begin(), view.targets().end(), g->targets.begin(), g->targets.end()));
+    }
+
+    Circuit loaded;
+    mapped.load(loaded);
+    EXPECT_EQ(loaded.toQasm(), circ.toQasm());
+    EXPECT_EQ(loaded.getInputs(), circ.getInputs());
+    EXPECT_EQ(loaded.getConstants(), circ.getConstants());
+    EXPECT_EQ(loaded.quantumCost(), circ.quantumCost());
+    for (auto it = circ.begin(), jt = loaded.begin(); it != circ.end(); ++it, ++jt) {
+        EXPECT_EQ(loaded.getAnnotations(**jt), circ.getAnnotations(**it));
+    }
+    EXPECT_THROW(mapped.load(loaded), std::invalid_argument);
+
+    // without annotations
+    ASSERT_TRUE(toBinaryFile(circ, binaryFileName, false));
+    const MappedCircuit withoutAnnotations(binaryFileName);
+    EXPECT_FALSE(withoutAnnotations.hasAnnotations());
+    Circuit loadedWithoutAnnotations;
+    withoutAnnotations.load(loadedWithoutAnnotations);
+    EXPECT_EQ(loadedWithoutAnnotations.toQasm(), circ.toQasm());
+    EXPECT_FALSE(loadedWithoutAnnotations.getAnnotations(**loadedWithoutAnnotations.begin()));
+}
+
+TEST(SyrecBinaryCircuitTest, Annotations) {
+    Circuit circ;
+    circ.setLines(2U);
+    circ.annotate(circ.appendCnot(0U, 1U), "lno", 7U);
+    auto& g = circ.appendNot(1U);
+    circ.annotate(g, "lno", "007");
+    circ.annotate(g, "label", "carry");
+
+    const auto fileName = testing::TempDir() + "annotations.bin";
+    ASSERT_TRUE(toBinaryFile(circ, fileName));
+    Circuit loaded;
+    MappedCircuit(fileName).load(loaded);
+    auto it = loaded.begin();
+    EXPECT_EQ(loaded.getUnsignedAnnotation(**it++, "lno"), 7U);
+    EXPECT_EQ(loaded.getAnnotation(**it, "lno"), "007");
+    EXPECT_EQ(loaded.getAnnotation(**it, "label"), "carry");
+}
+
+TEST(SyrecBinaryCircuitTest, Instances) {
+    auto sub = std::make_shared<Circuit>();
+    sub->setLines(3U);
+    sub->annotate(sub->appendCnot(0U, 1U), "lno", 3U);
+    sub->appendFredkin(1U, 2U);
+
+    Circuit circ;
+    circ.setLines(4U);
+    circ.appendNot(0U);
+    circ.appendInstance(sub, {3U, 2U, 1U});
+    circ.annotate(circ.appendCnot(0U, 3U), "lno", 5U);
+
+    // the gates of the instance are written at their position with their annotations, without expanding it
+    const auto fileName = testing::TempDir() + "instances.bin";
+    ASSERT_TRUE(toBinaryFile(circ, fileName));
+    EXPECT_EQ(circ.getInstances().size(), 1U);
+    Circuit loaded;
+    MappedCircuit(fileName).load(loaded);
+    EXPECT_EQ(loaded.numGates(), 4U);
+    EXPECT_EQ(loaded.toQasm(), circ.toQasm());
+    EXPECT_FALSE(loaded.getAnnotations(**loaded.begin()));
+    EXPECT_EQ(loaded.getUnsignedAnnotation(**std::next(loaded.begin()), "lno"), 3U);
+    EXPECT_EQ(loaded.getUnsignedAnnotation(**std::next(loaded.begin(), 3), "lno"), 5U);
+}
+
+TEST(SyrecBinaryCircuitTest, InvalidFiles) {
+    EXPECT_THROW(MappedCircuit(testing::TempDir() + "missing.bin"), std::runtime_error);
+
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendToffoli(0U, 1U, 2U);
+    const auto fileName = testing::TempDir() + "invalid.bin";
+    ASSERT_TRUE(toBinaryFile(circ, fileName));
+    std::string content;
+    {
+        std::ifstream is(fileName, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+    const auto writeModified = [&](const std::string& modified) {
+        std::ofstream os(fileName, std::ios::binary);
+        os << modified;
+    };
+
+    auto badMagic = content;
+    badMagic[0]   = 'X';
+    writeModified(badMagic);
+    EXPECT_THROW(MappedCircuit{fileName}, std::runtime_error);
+
+    writeModified(content.substr(0U, content.size() - 12U));
+    EXPECT_THROW(MappedCircuit{fileName}, std::runtime_error);
+
+    // the target of the gate, its third line index, lies beyond the lines
+    auto       badLine        = content;
+    const auto indicesOffset  = static_cast<std::size_t>(static_cast<unsigned char>(badLine[48]));
+    badLine[indicesOffset + 8U] = '\x09';
+    writeModified(badLine);
+    EXPECT_THROW(MappedCircuit{fileName}, std::runtime_error);
+}
+
+TEST(SyrecBinaryCircuitTest, UnwritableGates) {
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendToffoli(0U, 1U, 2U);
+    auto& g = circ.appendGate();
+    g.targets.emplace(0U);
+
+    // a gate without a type is rejected before anything is written
+    std::ostringstream os;
+    EXPECT_THROW(writeBinary(os, circ), std::invalid_argument);
+    EXPECT_TRUE(os.str().empty());
+    const auto fileName = testing::TempDir() + "unwritable.bin";
+    std::remove(fileName.c_str());
+    EXPECT_THROW(static_cast<void>(toBinaryFile(circ, fileName)), std::invalid_argument);
+    EXPECT_FALSE(std::ifstream(fileName).good());
+
+    // so is a gate on a line beyond the lines of the circuit
+    g.type    = Gate::Types::Toffoli;
+    g.targets = {5U};
+    EXPECT_THROW(writeBinary(os, circ), std::invalid_argument);
+
+    g.targets = {2U};
+    EXPECT_NO_THROW(writeBinary(os, circ));
+}
+
+TEST(SyrecBinaryCircuitTest, CorruptAnnotation) {
+    Circuit circ;
+    circ.setLines(2U);
+    circ.annotate(circ.appendCnot(0U, 1U), "lno", 7U);
+    const auto fileName = testing::TempDir() + "corrupt_annotation.bin";
+    ASSERT_TRUE(toBinaryFile(circ, fileName));
+    std::string content;
+    {
+        std::ifstream is(fileName, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    }
+
+    // the kind of the first annotation follows the number of annotations and its gate index
+    std::uint64_t annotationsOffset{};
+    std::memcpy(&annotationsOffset, content.data() + 56U, sizeof(annotationsOffset));
+    content[annotationsOffset + 16U] = '\x07';
+    {
+        std::ofstream os(fileName, std::ios::binary);
+        os << content;
+    }
+
+    // the circuit is left unchanged
+    Circuit loaded;
+    EXPECT_THROW(MappedCircuit(fileName).load(loaded), std::runtime_error);
+    EXPECT_EQ(loaded.getLines(), 0U);
+    EXPECT_EQ(loaded.numGates(), 0U);
+}
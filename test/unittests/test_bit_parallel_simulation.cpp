@@ -0,0 +1,143 @@
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecBitParallelSimulationTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecBitParallelSimulationTest, SyrecBitParallelSimulationTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "call_8",
+                                 "divide_2",
+                                 "for_4",
+                                 "modulo_2",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "shift_4",
+                                 "simple_add_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecBitParallelSimulationTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecBitParallelSimulationTest, GenericBitParallelSimulationTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+    // a batch size that is not a multiple of the word size also covers a partial last block
+    constexpr std::size_t                nPatterns = 3U * PATTERNS_PER_WORD + 17U;
+    std::mt19937_64                      rng(42U);
+    std::vector<boost::dynamic_bitset<>> inputs(nPatterns, boost::dynamic_bitset<>(circ.getLines()));
+    for (auto& input: inputs) {
+        for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+            input.set(l, (rng() & 1U) != 0U);
+        }
+    }
+
+    std::vector<boost::dynamic_bitset<>> outputs;
+    bitParallelSimulation(outputs, circ, inputs);
+    ASSERT_EQ(outputs.size(), nPatterns);
+
+    boost::dynamic_bitset<> expected(circ.getLines());
+    for (std::size_t k = 0U; k < nPatterns; ++k) {
+        simpleSimulation(expected, circ, inputs[k]);
+        EXPECT_EQ(expected, outputs[k]);
+    }
+}
+
+TEST(SyrecBitParallelSimulationTest, ControlledFredkinGate) {
+    Circuit circ;
+    circ.setLines(3U);
+    auto& g = circ.appendFredkin(1U, 2U);
+    g.controls.emplace(0U);
+
+    // all eight assignments of the three lines
+    std::vector<boost::dynamic_bitset<>> inputs;
+    for (unsigned long v = 0U; v < 8U; ++v) {
+        inputs.emplace_back(3U, v);
+    }
+
+    std::vector<boost::dynamic_bitset<>> outputs;
+    bitParallelSimulation(outputs, circ, inputs);
+
+    boost::dynamic_bitset<> expected(3U);
+    for (std::size_t k = 0U; k < inputs.size(); ++k) {
+        simpleSimulation(expected, circ, inputs[k]);
+        EXPECT_EQ(expected, outputs[k]);
+    }
+    // control set, targets differ: 0b011 -> 0b101
+    EXPECT_EQ(outputs[3].to_ulong(), 5U);
+}
+
+TEST(SyrecBitParallelSimulationTest, PackedPatterns) {
+    Circuit circ;
+    circ.setLines(10U);
+    circ.appendToffoli(0U, 9U, 1U);
+    circ.appendFredkin(2U, 8U).controls.emplace(1U);
+    const CompiledCircuit compiled(circ);
+
+    // two bytes per pattern, in place
+    std::vector<std::uint8_t> bytes = {0x01U, 0x02U, 0x05U, 0x02U, 0x00U, 0x00U};
+    bitParallelSimulation(bytes.data(), bytes.data(), 3U, 2U, compiled);
+    EXPECT_EQ(bytes, std::vector<std::uint8_t>({0x03U, 0x02U, 0x03U, 0x03U, 0x00U, 0x00U}));
+
+    // one word per pattern, with bits beyond the last line cleared
+    const std::vector<std::uint64_t> words = {0x201U, 0x205U, 0xFFFFFFFFFFFFFC00U};
+    std::vector<std::uint64_t>       outputs(words.size());
+    bitParallelSimulation(outputs.data(), words.data(), 3U, 1U, compiled);
+    EXPECT_EQ(outputs, std::vector<std::uint64_t>({0x203U, 0x303U, 0x000U}));
+
+    // a stride too small to hold all lines is rejected
+    EXPECT_THROW(bitParallelSimulation(bytes.data(), bytes.data(), 3U, 1U, compiled), std::invalid_argument);
+}
+
+TEST(SyrecBitParallelSimulationTest, PatternWidth) {
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendToffoli(0U, 1U, 2U);
+
+    // patterns with more or fewer bits than lines are rejected instead of being truncated or read beyond the lines
+    std::vector<boost::dynamic_bitset<>> outputs;
+    EXPECT_THROW(bitParallelSimulation(outputs, circ, {boost::dynamic_bitset<>(3U, 1U), boost::dynamic_bitset<>(5U, 0x10U)}), std::invalid_argument);
+    EXPECT_THROW(bitParallelSimulation(outputs, circ, {boost::dynamic_bitset<>(2U, 3U)}), std::invalid_argument);
+
+    // the block transposition round-trips patterns of the right width
+    const std::vector<boost::dynamic_bitset<>> patterns = {boost::dynamic_bitset<>(3U, 5U), boost::dynamic_bitset<>(3U, 2U)};
+    std::vector<PatternWord>                   lines(3U * 2U);
+    loadPatternBlock(lines, patterns.data(), patterns.size(), 2U);
+    EXPECT_EQ(lines, std::vector<PatternWord>({1U, 0U, 2U, 0U, 1U, 0U}));
+    std::vector<boost::dynamic_bitset<>> stored(patterns.size());
+    storePatternBlock(stored.data(), lines, stored.size(), 2U);
+    EXPECT_EQ(stored, patterns);
+}
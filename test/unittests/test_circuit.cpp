@@ -0,0 +1,413 @@
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace syrec;
+
+TEST(CircuitTest, StableGateHandles) {
+    Circuit circ;
+    circ.setLines(3U);
+
+    // enough gates to span several chunks of the gate store
+    constexpr std::size_t nGates = 1000U;
+    std::vector<const Gate*> handles;
+    for (std::size_t i = 0U; i < nGates; ++i) {
+        const Gate& g = circ.appendCnot(i % 3U, (i + 1U) % 3U);
+        circ.annotate(g, "index", std::to_string(i));
+        handles.emplace_back(&g);
+    }
+    Gate& first = circ.insertGate(0U);
+    first.type  = Gate::Types::Fredkin;
+    first.targets.emplace(0U);
+    first.targets.emplace(2U);
+
+    ASSERT_EQ(circ.numGates(), nGates + 1U);
+    auto it = circ.begin();
+    EXPECT_EQ(*it, &first);
+    for (std::size_t i = 0U; i < nGates; ++i) {
+        ++it;
+        ASSERT_EQ(*it, handles[i]);
+        EXPECT_EQ((*it)->type, Gate::Types::Toffoli);
+        EXPECT_EQ(*(*it)->controls.begin(), i % 3U);
+        EXPECT_EQ(*(*it)->targets.begin(), (i + 1U) % 3U);
+        const auto annotations = circ.getAnnotations(**it);
+        ASSERT_TRUE(annotations);
+        EXPECT_EQ(annotations->at("index"), std::to_string(i));
+    }
+    EXPECT_EQ(++it, circ.end());
+}
+
+TEST(CircuitTest, ForeignGateAnnotations) {
+    const Gate foreign;
+    Circuit    circ;
+    EXPECT_FALSE(circ.getAnnotations(foreign));
+    EXPECT_THROW(circ.annotate(foreign, "lno", "1"), std::invalid_argument);
+
+    circ.setLines(2U);
+    Circuit other;
+    other.setLines(2U);
+    for (unsigned i = 0U; i < 100U; ++i) {
+        circ.annotate(circ.appendCnot(0U, 1U), "lno", 1U);
+        other.annotate(other.appendCnot(0U, 1U), "lno", 1U);
+    }
+
+    // neither a gate outside of any circuit nor the gates of another circuit have annotations here
+    for (const auto* g: std::vector<const Gate*>{&foreign, *other.begin(), *std::prev(other.end())}) {
+        EXPECT_FALSE(circ.getAnnotations(*g));
+        EXPECT_FALSE(circ.getAnnotation(*g, "lno"));
+        EXPECT_FALSE(circ.getUnsignedAnnotation(*g, "lno"));
+        EXPECT_THROW(circ.annotate(*g, "lno", "2"), std::invalid_argument);
+        EXPECT_THROW(circ.annotate(*g, "lno", 2U), std::invalid_argument);
+    }
+    EXPECT_EQ(circ.getUnsignedAnnotation(**circ.begin(), "lno"), 1U);
+    EXPECT_EQ(other.getUnsignedAnnotation(**other.begin(), "lno"), 1U);
+}
+
+TEST(CircuitTest, InsertCircuit) {
+    const auto buildSub = [](Circuit& sub) {
+        sub.setLines(4U);
+        sub.annotate(sub.appendCnot(0U, 1U), "lno", "1");
+        sub.appendFredkin(1U, 2U);
+        sub.annotate(sub.appendToffoli(0U, 2U, 3U), "lno", "3");
+    };
+    const auto buildHost = [](Circuit& host) {
+        host.setLines(4U);
+        host.appendNot(0U);
+        host.appendNot(1U);
+    };
+
+    Circuit copied;
+    Circuit moved;
+    buildHost(copied);
+    buildHost(moved);
+    Circuit sub1;
+    Circuit sub2;
+    buildSub(sub1);
+    buildSub(sub2);
+    std::vector<const Gate*> subGates(sub2.begin(), sub2.end());
+
+    const Gate::line_container controls{3U};
+    copied.insertCircuit(1U, sub1, controls);
+    moved.insertCircuit(1U, std::move(sub2), controls);
+
+    // the source of the copy is unchanged, the moved-from circuit is empty
+    EXPECT_EQ(sub1.numGates(), 3U);
+    EXPECT_EQ(sub2.numGates(), 0U); // NOLINT(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+
+    ASSERT_EQ(copied.numGates(), 5U);
+    ASSERT_EQ(moved.numGates(), 5U);
+    auto itCopied = copied.begin();
+    auto itMoved  = moved.begin();
+    for (std::size_t i = 0U; i < 5U; ++i, ++itCopied, ++itMoved) {
+        const Gate& c = **itCopied;
+        const Gate& m = **itMoved;
+        EXPECT_EQ(c.type, m.type);
+        EXPECT_EQ(c.controls, m.controls);
+        EXPECT_EQ(c.targets, m.targets);
+        EXPECT_EQ(copied.getAnnotations(c), moved.getAnnotations(m));
+        if (i >= 1U && i <= 3U) {
+            // the moved gates keep their addresses and get the additional control
+            EXPECT_EQ(&m, subGates[i - 1U]);
+            EXPECT_EQ(m.controls.count(3U), 1U);
+        }
+    }
+    EXPECT_EQ(moved.getAnnotations(*subGates[0])->at("lno"), "1");
+    EXPECT_FALSE(moved.getAnnotations(*subGates[1]));
+    EXPECT_EQ(moved.getAnnotations(*subGates[2])->at("lno"), "3");
+}
+
+TEST(CircuitTest, Annotations) {
+    Circuit circ;
+    circ.setLines(2U);
+    const Gate& g0 = circ.appendNot(0U);
+    const Gate& g1 = circ.appendCnot(0U, 1U);
+    const Gate& g2 = circ.appendNot(1U);
+
+    circ.annotate(g0, "lno", 7U);
+    circ.annotate(g1, "lno", 12U);
+    circ.annotate(g1, "label", "carry");
+    EXPECT_EQ(circ.getUnsignedAnnotation(g0, "lno"), 7U);
+    EXPECT_EQ(circ.getAnnotation(g1, "lno"), "12");
+    EXPECT_EQ(circ.getAnnotation(g1, "label"), "carry");
+    EXPECT_FALSE(circ.getAnnotations(g2));
+    EXPECT_EQ(*circ.getAnnotations(g1), (std::map<std::string, std::string>{{"label", "carry"}, {"lno", "12"}}));
+
+    // string values in a numeric column keep all values
+    circ.annotate(g2, "lno", "unknown");
+    EXPECT_EQ(circ.getUnsignedAnnotation(g0, "lno"), 7U);
+    EXPECT_EQ(circ.getAnnotation(g2, "lno"), "unknown");
+    EXPECT_FALSE(circ.getUnsignedAnnotation(g2, "lno"));
+    EXPECT_FALSE(circ.getUnsignedAnnotation(g1, "label"));
+
+    // annotations move along with spliced gates
+    Circuit host;
+    host.setLines(2U);
+    host.annotate(host.appendNot(1U), "lno", 1U);
+    host.insertCircuit(0U, std::move(circ), {});
+    auto it = host.begin();
+    EXPECT_EQ(host.getUnsignedAnnotation(**it++, "lno"), 7U);
+    EXPECT_EQ(host.getAnnotation(**it++, "label"), "carry");
+    EXPECT_EQ(host.getAnnotation(**it++, "lno"), "unknown");
+    EXPECT_EQ(host.getAnnotation(**it, "lno"), "1");
+}
+
+TEST(CircuitTest, GateAddedHook) {
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendNot(0U);
+
+    std::vector<std::pair<std::size_t, const Gate*>> calls;
+    circ.gateAdded.connect([&](Gate& g) { calls.emplace_back(0U, &g); });
+    circ.gateAdded.connect([&](Gate& g) { calls.emplace_back(1U, &g); });
+    EXPECT_FALSE(circ.gateAdded.empty());
+
+    const Gate& g1 = circ.appendCnot(0U, 1U);
+    const Gate& g2 = circ.insertGate(0U);
+    ASSERT_EQ(calls.size(), 4U);
+    EXPECT_EQ(calls[0], std::make_pair(std::size_t{0U}, &g1));
+    EXPECT_EQ(calls[1], std::make_pair(std::size_t{1U}, &g1));
+    EXPECT_EQ(calls[2], std::make_pair(std::size_t{0U}, &g2));
+    EXPECT_EQ(calls[3], std::make_pair(std::size_t{1U}, &g2));
+
+    circ.gateAdded.disconnectAllSlots();
+    EXPECT_TRUE(circ.gateAdded.empty());
+    circ.appendNot(2U);
+    EXPECT_EQ(calls.size(), 4U);
+}
+
+TEST(CircuitTest, Metrics) {
+    Circuit circ;
+    circ.setLines(4U);
+    circ.appendNot(0U);
+    circ.appendCnot(0U, 1U);
+    circ.appendNot(2U);
+    circ.appendToffoli(1U, 2U, 3U);
+    EXPECT_EQ(circ.depth(), 3U);
+    EXPECT_EQ(circ.quantumCost(), 8U);
+    EXPECT_EQ(circ.transistorCost(), 24U);
+
+    // gates added after reading the metrics are counted on the next access
+    circ.appendFredkin(0U, 3U).controls.emplace(2U);
+    EXPECT_EQ(circ.depth(), 4U);
+    EXPECT_EQ(circ.getMetrics().numGates(Gate::Types::Fredkin, 1U), 1U);
+    EXPECT_EQ(circ.getMetrics().gateHistogram(), (CircuitMetrics::histogram{{{Gate::Types::Toffoli, 0U}, 2U}, {{Gate::Types::Toffoli, 1U}, 1U}, {{Gate::Types::Toffoli, 2U}, 1U}, {{Gate::Types::Fredkin, 1U}, 1U}}));
+
+    // inserting in front of counted gates changes the depth
+    Gate& g = circ.insertGate(0U);
+    g.controls.emplace(2U);
+    g.targets.emplace(0U);
+    g.type = Gate::Types::Toffoli;
+    EXPECT_EQ(circ.depth(), 5U);
+
+    // the quantum cost depends on the number of lines
+    const auto cost = circ.quantumCost();
+    circ.addLine("a", "a");
+    EXPECT_EQ(circ.quantumCost(), std::accumulate(circ.begin(), circ.end(), Gate::cost_t{}, [&](const auto sum, const auto* gate) { return sum + gate->quantumCost(circ.getLines()); }));
+    EXPECT_LE(circ.quantumCost(), cost);
+
+    // modifications in place are counted after recomputing
+    (*circ.begin())->controls.emplace(4U);
+    circ.recomputeMetrics(2U);
+    EXPECT_EQ(circ.transistorCost(), 48U);
+    EXPECT_EQ(circ.depth(), 5U);
+
+    // the histogram is counted in parallel chunks for large circuits
+    Circuit large;
+    large.setLines(8U);
+    for (std::size_t i = 0U; i < 20000U; ++i) {
+        large.appendCnot(i % 8U, (i + 1U) % 8U);
+    }
+    const auto depth = large.depth();
+    large.recomputeMetrics(4U);
+    EXPECT_EQ(large.depth(), depth);
+    EXPECT_EQ(large.getMetrics().numGates(Gate::Types::Toffoli, 1U), 20000U);
+    EXPECT_EQ(large.transistorCost(), 8U * 20000U);
+}
+
+TEST(CircuitTest, Instances) {
+    auto sub = std::make_shared<Circuit>();
+    sub->setLines(3U);
+    sub->annotate(sub->appendCnot(0U, 1U), "lno", 1U);
+    sub->appendToffoli(0U, 1U, 2U);
+    sub->appendFredkin(0U, 2U);
+
+    Circuit circ;
+    circ.setLines(5U);
+    circ.appendNot(4U);
+    circ.appendInstance(sub, {4U, 3U, 0U});
+    circ.appendInstance(sub, {1U, 2U, 3U}, true);
+    circ.appendCnot(0U, 1U);
+
+    // the same gates without instances
+    Circuit flat;
+    flat.setLines(5U);
+    flat.appendNot(4U);
+    flat.appendCnot(4U, 3U);
+    flat.appendToffoli(4U, 3U, 0U);
+    flat.appendFredkin(4U, 0U);
+    flat.appendFredkin(1U, 3U);
+    flat.appendToffoli(1U, 2U, 3U);
+    flat.appendCnot(1U, 2U);
+    flat.appendCnot(0U, 1U);
+
+    EXPECT_EQ(circ.numGates(), flat.numGates());
+    EXPECT_EQ(circ.quantumCost(), flat.quantumCost());
+    EXPECT_EQ(circ.transistorCost(), flat.transistorCost());
+    EXPECT_EQ(circ.depth(), flat.depth());
+
+    std::vector<Gate> visited;
+    circ.forEachGate([&visited](const Gate& g) { visited.emplace_back(g); });
+    ASSERT_EQ(visited.size(), flat.numGates());
+    auto it = flat.begin();
+    for (const auto& g: visited) {
+        EXPECT_EQ(g.type, (*it)->type);
+        EXPECT_EQ(g.controls, (*it)->controls);
+        EXPECT_EQ(g.targets, (*it)->targets);
+        ++it;
+    }
+
+    boost::dynamic_bitset<> output;
+    boost::dynamic_bitset<> expected;
+    for (unsigned long i = 0U; i < (1UL << circ.getLines()); ++i) {
+        const boost::dynamic_bitset<> input(circ.getLines(), i);
+        simpleSimulation(output, circ, input);
+        simpleSimulation(expected, flat, input);
+        EXPECT_EQ(output, expected) << i;
+    }
+
+    // the depth is taken from the dependencies, which index the gates of instances at their flat positions
+    ASSERT_EQ(circ.getDependencies().numGates(), flat.numGates());
+    for (std::size_t pos = 0U; pos < flat.numGates(); ++pos) {
+        EXPECT_EQ(circ.getDependencies().asap(pos), flat.getDependencies().asap(pos)) << pos;
+        EXPECT_EQ(circ.getDependencies().alap(pos), flat.getDependencies().alap(pos)) << pos;
+    }
+
+    // QASM is written from the hierarchy as well
+    EXPECT_EQ(circ.toQasm(), flat.toQasm());
+    std::stringstream qasm;
+    circ.toQasm(qasm, 2U);
+    EXPECT_EQ(qasm.str(), flat.toQasm());
+
+    // gates of instances are visited together with the gates they originate from
+    std::vector<std::optional<unsigned>> lnos;
+    circ.forEachGateWithOrigin([&](const Gate& /*g*/, const Circuit& owner, const Gate& original) {
+        EXPECT_TRUE(&owner == &circ || &owner == sub.get());
+        lnos.emplace_back(owner.getUnsignedAnnotation(original, "lno"));
+    });
+    ASSERT_EQ(lnos.size(), flat.numGates());
+    EXPECT_EQ(lnos[1], 1U);
+    EXPECT_EQ(lnos[6], 1U);
+    EXPECT_EQ(std::count(lnos.cbegin(), lnos.cend(), std::nullopt), 6);
+
+    // the const iterators refuse to skip the gates of instances
+    const auto& constCirc = circ;
+    EXPECT_THROW(static_cast<void>(constCirc.begin()), std::logic_error);
+    EXPECT_THROW(static_cast<void>(constCirc.cend()), std::logic_error);
+
+    // none of the above expands the instances
+    EXPECT_EQ(circ.getInstances().size(), 2U);
+
+    // gates added behind instances are counted on the next access
+    circ.appendInstance(sub, {0U, 1U, 2U});
+    flat.insertCircuit(flat.numGates(), *sub, {});
+    EXPECT_EQ(circ.numGates(), 11U);
+    EXPECT_EQ(circ.depth(), flat.depth());
+
+    // accessing single gates through a non-const circuit expands the instances into copies with their annotations
+    it = flat.begin();
+    for (const auto* g: circ) {
+        EXPECT_EQ(g->type, (*it)->type);
+        EXPECT_EQ(g->controls, (*it)->controls);
+        EXPECT_EQ(g->targets, (*it)->targets);
+        ++it;
+    }
+    EXPECT_TRUE(circ.getInstances().empty());
+    EXPECT_EQ(circ.numGates(), 11U);
+    EXPECT_EQ(circ.getUnsignedAnnotation(**std::next(circ.begin()), "lno"), 1U);
+    EXPECT_EQ(circ.getUnsignedAnnotation(**std::next(circ.begin(), 6), "lno"), 1U);
+    EXPECT_EQ(circ.depth(), flat.depth());
+    EXPECT_EQ(circ.quantumCost(), flat.quantumCost());
+    EXPECT_EQ(sub->numGates(), 3U);
+
+    // instances can be nested and are mapped through all levels
+    auto outer = std::make_shared<Circuit>();
+    outer->setLines(4U);
+    outer->appendInstance(sub, {3U, 2U, 1U});
+    outer->appendNot(0U);
+    Circuit nested;
+    nested.setLines(4U);
+    nested.appendInstance(outer, {1U, 2U, 3U, 0U}, true);
+    std::vector<Gate> nestedGates;
+    nested.forEachGate([&nestedGates](const Gate& g) { nestedGates.emplace_back(g); });
+    ASSERT_EQ(nestedGates.size(), 4U);
+    EXPECT_EQ(nestedGates[0].targets, Gate::line_container{1U});
+    EXPECT_EQ(nestedGates[1].targets, (Gate::line_container{0U, 2U}));
+    EXPECT_EQ(nestedGates[3].controls, Gate::line_container{0U});
+    EXPECT_EQ(nestedGates[3].targets, Gate::line_container{3U});
+    EXPECT_EQ(nested.depth(), 3U);
+    nested.flatten();
+    EXPECT_EQ((*std::prev(nested.end()))->targets, Gate::line_container{3U});
+
+    EXPECT_THROW(circ.appendInstance(sub, {0U, 1U}), std::invalid_argument);
+    EXPECT_THROW(circ.appendInstance(sub, {0U, 1U, 1U}), std::invalid_argument);
+    EXPECT_THROW(circ.appendInstance(sub, {0U, 1U, 5U}), std::invalid_argument);
+}
+
+TEST(CircuitTest, ConcurrentAnalyses) {
+    auto sub = std::make_shared<Circuit>();
+    sub->setLines(4U);
+    for (unsigned i = 0U; i < 1000U; ++i) {
+        sub->appendToffoli(i % 4U, (i + 1U) % 4U, (i + 2U) % 4U);
+    }
+
+    // parents sharing the sub-circuit, whose analyses are all computed on first access from different threads
+    constexpr std::size_t nParents = 4U;
+    std::vector<Circuit>  parents(nParents);
+    for (auto& parent: parents) {
+        parent.setLines(5U);
+        parent.appendInstance(sub, {4U, 3U, 2U, 1U});
+        parent.appendNot(0U);
+        parent.appendInstance(sub, {0U, 1U, 2U, 3U}, true);
+    }
+
+    std::vector<Gate::cost_t> costs(nParents * 2U);
+    std::vector<std::size_t>  depths(nParents * 2U);
+    std::vector<std::size_t>  alaps(nParents * 2U);
+    std::vector<std::thread>  threads;
+    for (std::size_t i = 0U; i < nParents * 2U; ++i) {
+        threads.emplace_back([&, i] {
+            const Circuit& parent = parents[i / 2U];
+            costs[i]              = parent.quantumCost();
+            depths[i]             = parent.depth();
+            alaps[i]              = parent.getDependencies().alap(0U) + sub->getDependencies().alap(0U);
+        });
+    }
+    for (auto& thread: threads) {
+        thread.join();
+    }
+
+    Circuit flat;
+    flat.setLines(5U);
+    flat.insertCircuit(0U, parents.front(), {});
+    for (std::size_t i = 0U; i < nParents * 2U; ++i) {
+        EXPECT_EQ(costs[i], flat.quantumCost());
+        EXPECT_EQ(depths[i], flat.depth());
+        EXPECT_EQ(alaps[i], flat.getDependencies().alap(0U) + sub->getDependencies().alap(0U));
+    }
+}
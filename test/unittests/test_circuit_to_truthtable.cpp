@@ -0,0 +1,84 @@
+#include "algorithms/simulation/circuit_to_truthtable.hpp"
+#include "core/circuit.hpp"
+#include "core/real/parser.hpp"
+#include "core/truthTable/truth_table.hpp"
+
+#include "gtest/gtest.h"
+#include <string>
+
+using namespace syrec;
+
+TEST(CircuitToTruthTableTest, ReversibleCircuitWithConstantLine) {
+    const std::string realString = ".version 2.0\n"
+                                   ".numvars 3\n"
+                                   ".variables a b c\n"
+                                   ".constants --0\n"
+                                   ".begin\n"
+                                   "t3 a b c\n"
+                                   "f2 a b\n"
+                                   ".end\n";
+    const auto qc = RealParser::imports(realString);
+
+    TruthTable tt{};
+    buildTruthTable(qc, tt, 1U);
+
+    // only the two primary inputs are enumerated
+    ASSERT_EQ(tt.size(), 4U);
+    for (const auto& [input, output]: tt) {
+        const auto in  = input.toBoolVec();
+        const auto out = output.toBoolVec();
+        EXPECT_FALSE(in[2]);
+        EXPECT_EQ(out[0], in[1]);
+        EXPECT_EQ(out[1], in[0]);
+        EXPECT_EQ(out[2], in[0] && in[1]);
+    }
+
+    // splitting the input space across threads yields the same table
+    TruthTable ttThreaded{};
+    buildTruthTable(qc, ttThreaded, 4U);
+    EXPECT_EQ(tt, ttThreaded);
+}
+
+TEST(CircuitToTruthTableTest, SyrecCircuitWithConstantLine) {
+    Circuit circ;
+    circ.addLine("a", "a");
+    circ.addLine("b", "b");
+    circ.addLine("c", "c", false);
+    circ.appendToffoli(0U, 1U, 2U);
+    circ.appendFredkin(0U, 1U);
+
+    TruthTable tt{};
+    buildTruthTable(circ, tt);
+
+    ASSERT_EQ(tt.size(), 4U);
+    EXPECT_EQ(tt.nPrimaryInputs(), 2U);
+    for (const auto& [input, output]: tt) {
+        const auto in  = input.toBoolVec();
+        const auto out = output.toBoolVec();
+        EXPECT_FALSE(in[2]);
+        EXPECT_EQ(out[0], in[1]);
+        EXPECT_EQ(out[1], in[0]);
+        EXPECT_EQ(out[2], in[0] && in[1]);
+    }
+}
+
+TEST(CircuitToTruthTableTest, SyrecCircuitWithGarbageLine) {
+    Circuit circ;
+    circ.addLine("a", "a", constant(), true);
+    circ.addLine("b", "b");
+    circ.addLine("c", "c", false);
+    circ.appendToffoli(0U, 1U, 2U);
+    circ.appendFredkin(0U, 1U);
+
+    // the garbage output a is reported as zero, like for a quantum computation
+    TruthTable tt{};
+    buildTruthTable(circ, tt);
+    ASSERT_EQ(tt.size(), 4U);
+    for (const auto& [input, output]: tt) {
+        const auto in  = input.toBoolVec();
+        const auto out = output.toBoolVec();
+        EXPECT_FALSE(out[0]);
+        EXPECT_EQ(out[1], in[0]);
+        EXPECT_EQ(out[2], in[0] && in[1]);
+    }
+}
@@ -0,0 +1,73 @@
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "algorithms/synthesis/syrec_cost_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+TEST(CompiledCircuitTest, FlattenedLayout) {
+    Circuit circ;
+    circ.setLines(70U);
+    circ.appendToffoli(3U, 65U, 1U);
+    circ.appendNot(69U);
+    auto& fredkin = circ.appendFredkin(2U, 5U);
+    fredkin.controls.emplace(0U);
+
+    const CompiledCircuit compiled(circ);
+    ASSERT_EQ(compiled.numGates(), 3U);
+    EXPECT_EQ(compiled.getLines(), 70U);
+    EXPECT_EQ(compiled.maskWords(), 2U);
+
+    EXPECT_EQ(compiled.type(0U), Gate::Types::Toffoli);
+    EXPECT_EQ(compiled.target1(0U), 1U);
+    ASSERT_EQ(compiled.numControls(0U), 2U);
+    EXPECT_EQ(compiled.controlsBegin(0U)[0], 3U);
+    EXPECT_EQ(compiled.controlsBegin(0U)[1], 65U);
+    EXPECT_EQ(compiled.controlMask(0U)[0], 1ULL << 3U);
+    EXPECT_EQ(compiled.controlMask(0U)[1], 1ULL << 1U);
+
+    EXPECT_EQ(compiled.numControls(1U), 0U);
+    EXPECT_EQ(compiled.controlsBegin(1U), compiled.controlsEnd(1U));
+    EXPECT_EQ(compiled.target1(1U), 69U);
+
+    EXPECT_EQ(compiled.type(2U), Gate::Types::Fredkin);
+    EXPECT_EQ(compiled.target1(2U), 2U);
+    EXPECT_EQ(compiled.target2(2U), 5U);
+    EXPECT_EQ(compiled.controlMask(2U)[0], 1ULL);
+}
+
+TEST(CompiledCircuitTest, MatchesGateSimulation) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+
+    EXPECT_TRUE(prog.read("./circuits/modulo_2.src", settings).empty());
+    EXPECT_TRUE(CostAwareSynthesis::synthesize(circ, prog));
+
+    const CompiledCircuit   compiled(circ);
+    std::mt19937_64         rng(7U);
+    boost::dynamic_bitset<> input(circ.getLines());
+    boost::dynamic_bitset<> output;
+    for (std::size_t k = 0U; k < 100U; ++k) {
+        for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+            input.set(l, (rng() & 1U) != 0U);
+        }
+
+        boost::dynamic_bitset<> expected = input;
+        for (const auto& g: circ) {
+            coreGateSimulation(*g, expected);
+        }
+
+        simpleSimulation(output, compiled, input);
+        EXPECT_EQ(expected, output);
+    }
+}
@@ -0,0 +1,139 @@
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/io/cpp_writer.hpp"
+#include "core/syrec/program.hpp"
+#include "generated_circuits.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecCppWriterTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecCppWriterTest, SyrecCppWriterTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "binary_numeric",
+                                 "bitwise_or_2",
+                                 "gray_binary_conversion_16",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "simple_add_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecCppWriterTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecCppWriterTest, GenericCppWriterTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+    // the emulator has been generated from the same program at build time
+    const auto* generated = std::find_if(std::begin(generatedCircuits), std::end(generatedCircuits), [&](const auto& c) { return c.name == GetParam(); });
+    ASSERT_NE(generated, std::end(generatedCircuits));
+    ASSERT_EQ(generated->lines, circ.getLines());
+
+    std::mt19937_64 rng(42U);
+    for (std::size_t block = 0U; block < 4U; ++block) {
+        std::vector<std::uint64_t> lines(circ.getLines());
+        std::generate(lines.begin(), lines.end(), [&rng]() { return rng(); });
+        const auto inputs = lines;
+        generated->simulate(lines.data());
+
+        for (std::size_t k = 0U; k < 64U; ++k) {
+            boost::dynamic_bitset<> input(circ.getLines());
+            boost::dynamic_bitset<> expected(circ.getLines());
+            boost::dynamic_bitset<> output(circ.getLines());
+            for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+                input.set(l, ((inputs[l] >> k) & 1U) != 0U);
+                output.set(l, ((lines[l] >> k) & 1U) != 0U);
+            }
+            simpleSimulation(expected, circ, input);
+            EXPECT_EQ(expected, output);
+        }
+    }
+}
+
+TEST(SyrecCppWriterTest, EmittedCode) {
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendNot(0U);
+    circ.appendToffoli(0U, 1U, 2U);
+    circ.appendFredkin(1U, 2U);
+    circ.appendFredkin(1U, 2U).controls.emplace(0U);
+
+    const auto code = toCpp(circ, "emulate");
+    EXPECT_NE(code.find("#pragma once"), std::string::npos);
+    EXPECT_NE(code.find("inline constexpr std::size_t emulate_lines = 3U;"), std::string::npos);
+    EXPECT_NE(code.find("inline void emulate(std::uint64_t* lines) {"), std::string::npos);
+    EXPECT_NE(code.find("    l0 = ~l0;\n"), std::string::npos);
+    EXPECT_NE(code.find("    l2 ^= l0 & l1;\n"), std::string::npos);
+    EXPECT_NE(code.find("const std::uint64_t d = l1 ^ l2;\n"), std::string::npos);
+    EXPECT_NE(code.find("const std::uint64_t d = (l1 ^ l2) & l0;\n"), std::string::npos);
+
+    EXPECT_THROW(static_cast<void>(toCpp(circ, "1st")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(toCpp(circ, "not-an-identifier")), std::invalid_argument);
+}
+
+TEST(SyrecCppWriterTest, NamesCannotEscapeComments) {
+    Circuit circ;
+    circ.setLines(2U);
+    circ.setInputs({"a\nint injected;", "b"});
+    circ.setOutputs({"a", "b\\"});
+    circ.appendCnot(0U, 1U);
+
+    const auto code = toCpp(circ, "emulate");
+    EXPECT_EQ(code.find("\nint injected;"), std::string::npos);
+    EXPECT_NE(code.find("// 0: a\\x0aint injected; -> a\n"), std::string::npos);
+    EXPECT_NE(code.find("// 1: b -> b\\x5c\n"), std::string::npos);
+}
+
+TEST(SyrecCppWriterTest, Instances) {
+    auto sub = std::make_shared<Circuit>();
+    sub->setLines(2U);
+    sub->appendNot(0U);
+    sub->appendFredkin(0U, 1U);
+
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendCnot(0U, 1U);
+    circ.appendInstance(sub, {2U, 0U});
+    circ.appendInstance(sub, {1U, 2U}, true);
+
+    // the gates of the instances are emitted like those of a flat copy
+    Circuit flat;
+    flat.setLines(3U);
+    flat.insertCircuit(0U, circ, {});
+    const auto code = toCpp(circ, "emulate");
+    EXPECT_EQ(code, toCpp(flat, "emulate"));
+    EXPECT_NE(code.find("3 lines and 5 gates"), std::string::npos);
+    EXPECT_NE(code.find("    l2 = ~l2;\n"), std::string::npos);
+    EXPECT_EQ(circ.getInstances().size(), 2U);
+}
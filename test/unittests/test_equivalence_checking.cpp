@@ -0,0 +1,105 @@
+#include "algorithms/simulation/equivalence_checking.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "algorithms/synthesis/syrec_cost_aware_synthesis.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace syrec;
+
+class SyrecEquivalenceCheckingTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    Circuit     lineAware;
+    Circuit     costAware;
+
+    void SetUp() override {
+        Program             prog;
+        ReadProgramSettings readSettings;
+        EXPECT_TRUE(prog.read(testCircuitsDir + GetParam() + ".src", readSettings).empty());
+        EXPECT_TRUE(LineAwareSynthesis::synthesize(lineAware, prog));
+        EXPECT_TRUE(CostAwareSynthesis::synthesize(costAware, prog));
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecEquivalenceCheckingTest, SyrecEquivalenceCheckingTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "bitwise_and_2",
+                                 "divide_2",
+                                 "modulo_2",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "simple_add_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecEquivalenceCheckingTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecEquivalenceCheckingTest, LineAwareAndCostAwareSynthesis) {
+    boost::dynamic_bitset<> counterexample;
+    EXPECT_EQ(EquivalenceResult::Equivalent, checkEquivalence(counterexample, lineAware, costAware));
+
+    // without the exhaustive proof, random simulation cannot refute equivalence either
+    auto settings = std::make_shared<Properties>();
+    settings->set("exhaustive_inputs", 0U);
+    settings->set("num_threads", 1U);
+    EXPECT_EQ(EquivalenceResult::ProbablyEquivalent, checkEquivalence(counterexample, lineAware, costAware, settings));
+}
+
+TEST_P(SyrecEquivalenceCheckingTest, FaultyCircuit) {
+    // flip the first primary output for one assignment of the primary inputs
+    const auto& garbage   = costAware.getGarbage();
+    const auto& constants = costAware.getConstants();
+    const auto  output    = static_cast<std::size_t>(std::find(garbage.cbegin(), garbage.cend(), false) - garbage.cbegin());
+    ASSERT_LT(output, costAware.getLines());
+    auto& g = costAware.appendNot(output);
+    for (std::size_t l = 0U; l < costAware.getLines(); ++l) {
+        if (l != output && !constants[l] && !garbage[l]) {
+            g.controls.emplace(l);
+        }
+    }
+
+    boost::dynamic_bitset<> counterexample;
+    ASSERT_EQ(EquivalenceResult::NotEquivalent, checkEquivalence(counterexample, lineAware, costAware));
+    ASSERT_EQ(counterexample.size(), lineAware.getLines());
+
+    // the counterexample distinguishes the circuits
+    boost::dynamic_bitset<> input2(costAware.getLines());
+    for (std::size_t l2 = 0U; l2 < costAware.getLines(); ++l2) {
+        if (constants[l2]) {
+            input2.set(l2, *constants[l2]);
+            continue;
+        }
+        const auto& inputs1 = lineAware.getInputs();
+        const auto  l1      = static_cast<std::size_t>(std::find(inputs1.cbegin(), inputs1.cend(), costAware.getInputs()[l2]) - inputs1.cbegin());
+        input2.set(l2, counterexample.test(l1));
+    }
+    boost::dynamic_bitset<> output1;
+    boost::dynamic_bitset<> output2;
+    simpleSimulation(output1, lineAware, counterexample);
+    simpleSimulation(output2, costAware, input2);
+
+    const auto& outputs1 = lineAware.getOutputs();
+    const auto  l1       = static_cast<std::size_t>(std::find(outputs1.cbegin(), outputs1.cend(), costAware.getOutputs()[output]) - outputs1.cbegin());
+    EXPECT_NE(output1.test(l1), output2.test(output));
+}
+
+TEST(SyrecEquivalenceCheckingTest, IncompatibleInterfaces) {
+    Circuit circ1;
+    circ1.addLine("a", "a", constant(), false);
+    Circuit circ2;
+    circ2.addLine("b", "a", constant(), false);
+
+    boost::dynamic_bitset<> counterexample;
+    EXPECT_EQ(EquivalenceResult::IncompatibleInterfaces, checkEquivalence(counterexample, circ1, circ2));
+}
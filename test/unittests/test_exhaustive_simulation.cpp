@@ -0,0 +1,113 @@
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/exhaustive_simulation.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecExhaustiveSimulationTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string     testCircuitsDir = "./circuits/";
+    Circuit         circ;
+    Properties::ptr settings = std::make_shared<Properties>();
+
+    void SetUp() override {
+        Program             prog;
+        ReadProgramSettings readSettings;
+        EXPECT_TRUE(prog.read(testCircuitsDir + GetParam() + ".src", readSettings).empty());
+        EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+        // small chunks on several threads exercise the work stealing
+        settings->set("num_threads", 4U);
+        settings->set("chunk_size", 1U);
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecExhaustiveSimulationTest, SyrecExhaustiveSimulationTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "bitwise_and_2",
+                                 "modulo_2",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "simple_add_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecExhaustiveSimulationTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecExhaustiveSimulationTest, SinkMatchesSimpleSimulation) {
+    const std::uint64_t                  nPatterns = 1ULL << numPrimaryInputs(circ);
+    std::vector<boost::dynamic_bitset<>> outputs(nPatterns);
+    std::mutex                           mutex;
+
+    exhaustiveSimulation(
+            circ, [&](const std::uint64_t firstInput, const std::size_t count, const std::vector<PatternWord>& lines) {
+                const std::lock_guard lock(mutex);
+                for (std::size_t k = 0U; k < count; ++k) {
+                    auto& output = outputs[firstInput + k];
+                    EXPECT_TRUE(output.empty());
+                    output.resize(circ.getLines());
+                    for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+                        output.set(l, ((lines[l] >> k) & 1U) != 0U);
+                    }
+                }
+            },
+            settings);
+
+    boost::dynamic_bitset<> expected;
+    for (std::uint64_t i = 0U; i < nPatterns; ++i) {
+        simpleSimulation(expected, circ, exhaustiveInputPattern(circ, i));
+        EXPECT_EQ(expected, outputs[i]);
+    }
+}
+
+TEST_P(SyrecExhaustiveSimulationTest, PackedOutputsMatchSimpleSimulation) {
+    std::vector<std::uint64_t> outputs;
+    exhaustiveSimulation(outputs, circ, settings);
+
+    const std::uint64_t nPatterns       = 1ULL << numPrimaryInputs(circ);
+    const std::size_t   wordsPerPattern = (circ.getLines() + 63U) / 64U;
+    ASSERT_EQ(outputs.size(), nPatterns * wordsPerPattern);
+
+    boost::dynamic_bitset<> expected;
+    for (std::uint64_t i = 0U; i < nPatterns; ++i) {
+        simpleSimulation(expected, circ, exhaustiveInputPattern(circ, i));
+        for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+            EXPECT_EQ(expected.test(l), ((outputs[(i * wordsPerPattern) + (l / 64U)] >> (l % 64U)) & 1U) != 0U);
+        }
+    }
+}
+
+TEST(SyrecExhaustiveSimulationTest, TooManyInputs) {
+    Circuit circ;
+    circ.setLines(64U);
+
+    std::vector<std::uint64_t> outputs;
+    EXPECT_THROW(exhaustiveSimulation(outputs, circ), std::invalid_argument);
+
+    // rejected before the number of patterns is computed, which would overflow
+    circ.setLines(80U);
+    EXPECT_THROW(exhaustiveSimulation(outputs, circ), std::invalid_argument);
+    EXPECT_TRUE(outputs.empty());
+
+    // enumerable, but too many patterns to store
+    circ.setLines(63U);
+    EXPECT_THROW(exhaustiveSimulation(outputs, circ), std::length_error);
+    EXPECT_TRUE(outputs.empty());
+}
@@ -0,0 +1,129 @@
+#include "algorithms/simulation/exhaustive_simulation.hpp"
+#include "algorithms/simulation/fault_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecFaultSimulationTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    Circuit     circ;
+
+    void SetUp() override {
+        Program             prog;
+        ReadProgramSettings readSettings;
+        EXPECT_TRUE(prog.read(testCircuitsDir + GetParam() + ".src", readSettings).empty());
+        EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecFaultSimulationTest, SyrecFaultSimulationTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "bitwise_and_2",
+                                 "modulo_2",
+                                 "negate_8",
+                                 "simple_add_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecFaultSimulationTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecFaultSimulationTest, GeneratedTestSetIsComplete) {
+    const auto faults = enumerateFaults(circ);
+
+    // all input assignments detect every detectable fault
+    std::vector<boost::dynamic_bitset<>> exhaustive;
+    for (std::uint64_t i = 0U; i < (std::uint64_t{1U} << numPrimaryInputs(circ)); ++i) {
+        exhaustive.emplace_back(exhaustiveInputPattern(circ, i));
+    }
+    std::vector<bool> expected;
+    const double      expectedCoverage = faultSimulation(expected, circ, faults, exhaustive);
+
+    std::vector<boost::dynamic_bitset<>> tests;
+    auto                                 statistics = std::make_shared<Properties>();
+    EXPECT_DOUBLE_EQ(expectedCoverage, generateTestSet(tests, circ, faults, Properties::ptr(), statistics));
+    EXPECT_DOUBLE_EQ(expectedCoverage, statistics->get<double>("coverage"));
+    EXPECT_LE(tests.size(), exhaustive.size());
+
+    // the same faults are detected by the compact test set, also on a single thread
+    auto settings = std::make_shared<Properties>();
+    settings->set("num_threads", 1U);
+    std::vector<bool> detected;
+    EXPECT_DOUBLE_EQ(expectedCoverage, faultSimulation(detected, circ, faults, tests, settings));
+    EXPECT_EQ(expected, detected);
+}
+
+TEST(SyrecFaultSimulationTest, SingleCnot) {
+    Circuit circ;
+    circ.setLines(2U);
+    circ.appendCnot(0U, 1U);
+
+    const std::vector<Fault> faults = {
+            {Fault::Types::MissingGate, 0U, 0U},
+            {Fault::Types::RepeatedGate, 0U, 0U},
+            {Fault::Types::StuckAt0, 0U, 0U},
+            {Fault::Types::StuckAt1, 1U, 1U}};
+
+    std::vector<bool> detected;
+
+    // the gate is not activated by the input 00, but line 1 is 0 at the output
+    EXPECT_DOUBLE_EQ(0.25, faultSimulation(detected, circ, faults, {boost::dynamic_bitset<>(2U, 0U)}));
+    EXPECT_EQ(std::vector<bool>({false, false, false, true}), detected);
+
+    // the input 10 (line 0 set) activates the gate, and line 1 is 1 at the output
+    EXPECT_DOUBLE_EQ(0.75, faultSimulation(detected, circ, faults, {boost::dynamic_bitset<>(2U, 1U)}));
+    EXPECT_EQ(std::vector<bool>({true, true, true, false}), detected);
+
+    EXPECT_THROW(faultSimulation(detected, circ, faults, {boost::dynamic_bitset<>(3U, 4U)}), std::invalid_argument);
+}
+
+TEST(SyrecFaultSimulationTest, LargeCircuitCheckpoints) {
+    // a circuit with far more gates than recorded states
+    Circuit circ;
+    circ.setLines(8U);
+    std::mt19937                            generator(42U);
+    std::uniform_int_distribution<unsigned> line(0U, 7U);
+    for (unsigned i = 0U; i < 3000U; ++i) {
+        const auto target  = line(generator);
+        const auto control = (target + 1U + line(generator) % 7U) % 8U;
+        if (i % 3U == 0U) {
+            circ.appendNot(target);
+        } else {
+            circ.appendCnot(control, target);
+        }
+    }
+
+    const auto                           faults = enumerateFaults(circ);
+    std::vector<boost::dynamic_bitset<>> tests;
+    for (unsigned i = 0U; i < 64U; ++i) {
+        tests.emplace_back(8U, generator());
+    }
+
+    // recording the state in front of every gate yields the same result as re-simulating from checkpoints
+    auto settings = std::make_shared<Properties>();
+    settings->set("checkpoint_interval", 1U);
+    std::vector<bool> expected;
+    const double      expectedCoverage = faultSimulation(expected, circ, faults, tests, settings);
+
+    for (const auto interval: {0U, 7U, 3000U}) {
+        settings->set("checkpoint_interval", interval);
+        std::vector<bool> detected;
+        EXPECT_DOUBLE_EQ(expectedCoverage, faultSimulation(detected, circ, faults, tests, settings)) << interval;
+        EXPECT_EQ(expected, detected) << interval;
+    }
+}
@@ -0,0 +1,97 @@
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "core/circuit.hpp"
+#include "core/gate.hpp"
+
+#include "gtest/gtest.h"
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecFixedWidthSimulationTest: public testing::TestWithParam<unsigned> {
+protected:
+    std::mt19937_64 rng{12345U};
+
+    Gate::line randomLine(const Gate::line_container& used) {
+        Gate::line l = rng() % GetParam();
+        while (used.count(l) != 0U) {
+            l = rng() % GetParam();
+        }
+        return l;
+    }
+
+    // random Toffoli and Fredkin gates with up to three controls
+    void buildRandomCircuit(Circuit& circ) {
+        circ.setLines(GetParam());
+        for (std::size_t i = 0U; i < 500U; ++i) {
+            Gate::line_container used;
+            Gate&                g = circ.appendGate();
+            const auto           c = rng() % 4U;
+            for (std::size_t j = 0U; j < c; ++j) {
+                const auto l = randomLine(used);
+                used.emplace(l);
+                g.controls.emplace(l);
+            }
+            const auto t1 = randomLine(used);
+            used.emplace(t1);
+            g.targets.emplace(t1);
+            if ((rng() & 1U) != 0U) {
+                g.targets.emplace(randomLine(used));
+                g.type = Gate::Types::Fredkin;
+            } else {
+                g.type = Gate::Types::Toffoli;
+            }
+        }
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecFixedWidthSimulationTest, SyrecFixedWidthSimulationTest,
+                         testing::Values(5U, 64U, 65U, 128U, 130U, 200U, 256U, 257U, 300U));
+
+TEST_P(SyrecFixedWidthSimulationTest, MatchesGateSimulation) {
+    Circuit circ;
+    buildRandomCircuit(circ);
+
+    const CompiledCircuit   compiled(circ);
+    boost::dynamic_bitset<> input(circ.getLines());
+    boost::dynamic_bitset<> output;
+    for (std::size_t k = 0U; k < 50U; ++k) {
+        for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+            input.set(l, (rng() & 1U) != 0U);
+        }
+
+        boost::dynamic_bitset<> expected = input;
+        for (const auto& g: circ) {
+            coreGateSimulation(*g, expected);
+        }
+
+        simpleSimulation(output, compiled, input);
+        EXPECT_EQ(expected, output);
+    }
+}
+
+TEST_P(SyrecFixedWidthSimulationTest, KeepsBitsBeyondLines) {
+    Circuit circ;
+    buildRandomCircuit(circ);
+
+    // inputs wider than the circuit, also beyond the words of the fixed-width state
+    const CompiledCircuit   compiled(circ);
+    boost::dynamic_bitset<> input(circ.getLines() + 200U);
+    boost::dynamic_bitset<> output;
+    for (std::size_t k = 0U; k < 10U; ++k) {
+        for (std::size_t l = 0U; l < input.size(); ++l) {
+            input.set(l, (rng() & 1U) != 0U);
+        }
+
+        boost::dynamic_bitset<> expected = input;
+        for (const auto& g: circ) {
+            coreGateSimulation(*g, expected);
+        }
+
+        simpleSimulation(output, compiled, input);
+        EXPECT_EQ(expected, output);
+    }
+}
@@ -0,0 +1,130 @@
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/gate_dependencies.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecGateDependenciesTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecGateDependenciesTest, SyrecGateDependenciesTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "binary_numeric",
+                                 "for_4",
+                                 "multiply_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecGateDependenciesTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecGateDependenciesTest, GenericGateDependenciesTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+    const auto& dependencies = circ.getDependencies();
+    ASSERT_EQ(dependencies.numGates(), circ.numGates());
+    EXPECT_EQ(dependencies.depth(), circ.depth());
+
+    std::size_t occupied = 0U;
+    for (unsigned l = 0U; l < circ.getLines(); ++l) {
+        const auto gates = dependencies.gatesOn(l);
+        EXPECT_TRUE(std::is_sorted(gates.begin(), gates.end()));
+        occupied += gates.size();
+    }
+
+    std::size_t pos = 0U;
+    for (const auto* g: circ) {
+        occupied -= g->controls.size() + g->targets.size();
+        EXPECT_LE(dependencies.asap(pos), dependencies.alap(pos));
+        EXPECT_LT(dependencies.alap(pos), dependencies.depth());
+        for (const auto p: dependencies.predecessorsOf(pos)) {
+            EXPECT_LT(dependencies.asap(p), dependencies.asap(pos));
+            const auto successors = dependencies.successorsOf(p);
+            EXPECT_NE(std::find(successors.cbegin(), successors.cend(), pos), successors.cend());
+        }
+        for (const auto s: dependencies.successorsOf(pos)) {
+            EXPECT_GT(dependencies.alap(s), dependencies.alap(pos));
+        }
+        ++pos;
+    }
+    EXPECT_EQ(occupied, 0U);
+
+    // the incrementally maintained index matches the one built in one pass
+    const auto built = GateDependencies::build(circ.begin(), circ.end());
+    for (pos = 0U; pos < circ.numGates(); ++pos) {
+        EXPECT_EQ(built.asap(pos), dependencies.asap(pos));
+        EXPECT_EQ(built.alap(pos), dependencies.alap(pos));
+    }
+}
+
+TEST(SyrecGateDependenciesTest, Layers) {
+    Circuit circ;
+    circ.setLines(4U);
+    circ.appendNot(0U);
+    circ.appendCnot(0U, 1U);
+    circ.appendNot(2U);
+    circ.appendToffoli(1U, 2U, 3U);
+    circ.appendCnot(0U, 2U);
+
+    const auto& dependencies = circ.getDependencies();
+    EXPECT_EQ(dependencies.depth(), 4U);
+    EXPECT_EQ(std::vector<std::size_t>(dependencies.gatesOn(0U).begin(), dependencies.gatesOn(0U).end()), (std::vector<std::size_t>{0U, 1U, 4U}));
+    EXPECT_EQ(std::vector<std::size_t>(dependencies.gatesOn(2U).begin(), dependencies.gatesOn(2U).end()), (std::vector<std::size_t>{2U, 3U, 4U}));
+    EXPECT_TRUE(dependencies.gatesOn(7U).empty());
+
+    EXPECT_TRUE(dependencies.predecessorsOf(0U).empty());
+    EXPECT_EQ(std::vector<std::size_t>(dependencies.predecessorsOf(3U).begin(), dependencies.predecessorsOf(3U).end()), (std::vector<std::size_t>{1U, 2U}));
+    EXPECT_EQ(std::vector<std::size_t>(dependencies.predecessorsOf(4U).begin(), dependencies.predecessorsOf(4U).end()), (std::vector<std::size_t>{1U, 3U}));
+    EXPECT_EQ(dependencies.successorsOf(1U), (std::vector<std::size_t>{3U, 4U}));
+    EXPECT_TRUE(dependencies.successorsOf(4U).empty());
+
+    const std::vector<std::size_t> asap{0U, 1U, 0U, 2U, 3U};
+    const std::vector<std::size_t> alap{0U, 1U, 1U, 2U, 3U};
+    for (std::size_t pos = 0U; pos < circ.numGates(); ++pos) {
+        EXPECT_EQ(dependencies.asap(pos), asap[pos]) << pos;
+        EXPECT_EQ(dependencies.alap(pos), alap[pos]) << pos;
+    }
+
+    // gates added after building the index are appended on the next access
+    circ.appendCnot(3U, 2U);
+    EXPECT_EQ(circ.getDependencies().numGates(), 6U);
+    EXPECT_EQ(circ.getDependencies().asap(5U), 4U);
+    EXPECT_EQ(circ.getDependencies().alap(5U), 4U);
+    EXPECT_EQ(circ.getDependencies().depth(), 5U);
+
+    // inserting in front of indexed gates shifts their positions
+    circ.insertGate(0U).targets.emplace(1U);
+    EXPECT_EQ(std::vector<std::size_t>(circ.getDependencies().gatesOn(1U).begin(), circ.getDependencies().gatesOn(1U).end()), (std::vector<std::size_t>{0U, 2U, 4U}));
+    EXPECT_EQ(circ.getDependencies().asap(2U), 1U);
+    EXPECT_EQ(circ.getDependencies().depth(), 5U);
+
+    // modifications in place are indexed after rebuilding
+    (*circ.begin())->targets = {3U};
+    EXPECT_EQ(circ.getDependencies().gatesOn(1U).size(), 3U);
+    circ.rebuildDependencies();
+    EXPECT_EQ(std::vector<std::size_t>(circ.getDependencies().gatesOn(1U).begin(), circ.getDependencies().gatesOn(1U).end()), (std::vector<std::size_t>{2U, 4U}));
+    EXPECT_EQ(std::vector<std::size_t>(circ.getDependencies().gatesOn(3U).begin(), circ.getDependencies().gatesOn(3U).end()), (std::vector<std::size_t>{0U, 4U, 6U}));
+}
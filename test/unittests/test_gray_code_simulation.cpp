@@ -0,0 +1,86 @@
+#include "algorithms/simulation/exhaustive_simulation.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecGrayCodeSimulationTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    Circuit     circ;
+
+    void SetUp() override {
+        Program             prog;
+        ReadProgramSettings readSettings;
+        EXPECT_TRUE(prog.read(testCircuitsDir + GetParam() + ".src", readSettings).empty());
+        EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+    }
+
+    void checkAgainstSimpleSimulation(const Properties::ptr& settings) {
+        const std::uint64_t                  nPatterns = 1ULL << numPrimaryInputs(circ);
+        std::vector<boost::dynamic_bitset<>> outputs(nPatterns);
+
+        exhaustiveSimpleSimulation(
+                circ, [&](const std::uint64_t input, const boost::dynamic_bitset<>& output) {
+                    ASSERT_LT(input, nPatterns);
+                    EXPECT_TRUE(outputs[input].empty());
+                    outputs[input] = output;
+                },
+                settings);
+
+        boost::dynamic_bitset<> expected;
+        for (std::uint64_t i = 0U; i < nPatterns; ++i) {
+            simpleSimulation(expected, circ, exhaustiveInputPattern(circ, i));
+            EXPECT_EQ(expected, outputs[i]);
+        }
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecGrayCodeSimulationTest, SyrecGrayCodeSimulationTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "bitwise_and_2",
+                                 "modulo_2",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "simple_add_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecGrayCodeSimulationTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecGrayCodeSimulationTest, GrayCodeOrder) {
+    checkAgainstSimpleSimulation(std::make_shared<Properties>());
+}
+
+TEST_P(SyrecGrayCodeSimulationTest, GrayCodeOrderWithDenseCheckpoints) {
+    auto settings = std::make_shared<Properties>();
+    settings->set("checkpoint_interval", 1U);
+    checkAgainstSimpleSimulation(settings);
+}
+
+TEST_P(SyrecGrayCodeSimulationTest, BinaryOrder) {
+    auto settings = std::make_shared<Properties>();
+    settings->set("gray_code", false);
+    checkAgainstSimpleSimulation(settings);
+}
+
+TEST(SyrecGrayCodeSimulationTest, TooManyInputs) {
+    Circuit circ;
+    circ.setLines(64U);
+
+    EXPECT_THROW(exhaustiveSimpleSimulation(circ, [](const std::uint64_t /*input*/, const boost::dynamic_bitset<>& /*output*/) {}), std::invalid_argument);
+}
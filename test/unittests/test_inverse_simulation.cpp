@@ -0,0 +1,134 @@
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/inverse_simulation.hpp"
+#include "algorithms/simulation/simple_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecInverseSimulationTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecInverseSimulationTest, SyrecInverseSimulationTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "call_8",
+                                 "divide_2",
+                                 "modulo_2",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecInverseSimulationTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecInverseSimulationTest, GenericInverseSimulationTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+    // feasible inputs, i.e., with all constant lines at their values
+    const auto&                          constants = circ.getConstants();
+    std::mt19937_64                      rng(42U);
+    std::vector<boost::dynamic_bitset<>> inputs(100U, boost::dynamic_bitset<>(circ.getLines()));
+    std::vector<boost::dynamic_bitset<>> outputs(inputs.size());
+    for (std::size_t k = 0U; k < inputs.size(); ++k) {
+        for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+            inputs[k].set(l, constants[l] ? *constants[l] : (rng() & 1U) != 0U);
+        }
+        EXPECT_TRUE(isFeasiblePreimage(circ, inputs[k]));
+        simpleSimulation(outputs[k], circ, inputs[k]);
+    }
+
+    boost::dynamic_bitset<> input;
+    for (std::size_t k = 0U; k < inputs.size(); ++k) {
+        inverseSimulation(input, circ, outputs[k]);
+        EXPECT_EQ(inputs[k], input);
+    }
+
+    std::vector<boost::dynamic_bitset<>> batch;
+    inverseBitParallelSimulation(batch, circ, outputs);
+    EXPECT_EQ(inputs, batch);
+
+    const auto inverse = CompiledCircuit(circ).inverse();
+    for (std::size_t k = 0U; k < inputs.size(); ++k) {
+        simpleSimulation(input, inverse, outputs[k]);
+        EXPECT_EQ(inputs[k], input);
+    }
+}
+
+TEST(SyrecInverseSimulationTest, PreimagesWithGarbage) {
+    // a = constant 0, b, c: computes a ^= b & c, line c is garbage
+    Circuit circ;
+    circ.addLine("a", "a", false, false);
+    circ.addLine("b", "b", constant(), false);
+    circ.addLine("c", "c", constant(), true);
+    circ.appendToffoli(1U, 2U, 0U);
+
+    std::vector<boost::dynamic_bitset<>> inputs;
+
+    // a = 1 requires b = c = 1
+    EXPECT_TRUE(findPreimages(inputs, circ, boost::dynamic_bitset<>(3U, 0b011U)));
+    EXPECT_EQ(inputs, std::vector<boost::dynamic_bitset<>>({boost::dynamic_bitset<>(3U, 0b110U)}));
+
+    // a = 0 with b = 1 requires c = 0, regardless of the given garbage value
+    EXPECT_TRUE(findPreimages(inputs, circ, boost::dynamic_bitset<>(3U, 0b110U)));
+    EXPECT_EQ(inputs, std::vector<boost::dynamic_bitset<>>({boost::dynamic_bitset<>(3U, 0b010U)}));
+
+    // a = 0 with b = 0 is produced for both values of c
+    EXPECT_TRUE(findPreimages(inputs, circ, boost::dynamic_bitset<>(3U, 0b000U)));
+    EXPECT_EQ(inputs.size(), 2U);
+
+    // a = 1 with b = 0 is not reachable from a = 0
+    EXPECT_FALSE(findPreimages(inputs, circ, boost::dynamic_bitset<>(3U, 0b001U)));
+    EXPECT_TRUE(inputs.empty());
+}
+
+TEST(SyrecInverseSimulationTest, TooManyGarbageOutputs) {
+    Circuit circ;
+    circ.setLines(64U);
+    circ.setGarbage(std::vector<bool>(64U, true));
+
+    std::vector<boost::dynamic_bitset<>> inputs;
+    EXPECT_THROW(findPreimages(inputs, circ, boost::dynamic_bitset<>(64U)), std::invalid_argument);
+
+    // the cap is checked before anything is simulated and cannot be raised beyond 63 garbage lines
+    const auto settings = std::make_shared<Properties>();
+    settings->set("max_garbage_lines", 64U);
+    EXPECT_THROW(findPreimages(inputs, circ, boost::dynamic_bitset<>(64U), settings), std::invalid_argument);
+
+    circ.setGarbage(std::vector<bool>(25U, true));
+    EXPECT_THROW(findPreimages(inputs, circ, boost::dynamic_bitset<>(64U)), std::invalid_argument);
+    settings->set("max_garbage_lines", 2U);
+    circ.setGarbage(std::vector<bool>(3U, true));
+    EXPECT_THROW(findPreimages(inputs, circ, boost::dynamic_bitset<>(64U), settings), std::invalid_argument);
+    circ.setGarbage(std::vector<bool>(2U, true));
+    EXPECT_TRUE(findPreimages(inputs, circ, boost::dynamic_bitset<>(64U), settings));
+    EXPECT_EQ(inputs.size(), 4U);
+}
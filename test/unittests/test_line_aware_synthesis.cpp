@@ -98,7 +98,5 @@ TEST_P(SyrecSynthesisTest, GenericSynthesisQASMTest) {
     EXPECT_TRUE(errorString.empty());
     EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
 
-    const auto lastIndex      = fileName.find_last_of('.');
-    const auto outputFileName = fileName.substr(0, lastIndex);
-    EXPECT_TRUE(circ.toQasmFile(outputFileName + ".qasm"));
+    EXPECT_TRUE(circ.toQasmFile(testing::TempDir() + GetParam() + ".qasm"));
 }
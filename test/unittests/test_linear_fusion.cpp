@@ -0,0 +1,170 @@
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/linear_fusion.hpp"
+#include "algorithms/synthesis/syrec_cost_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/properties.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecLinearFusionTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecLinearFusionTest, SyrecLinearFusionTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "binary_numeric",
+                                 "bitwise_or_2",
+                                 "divide_2",
+                                 "gray_binary_conversion_16",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "parity_check_16",
+                                 "simple_add_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecLinearFusionTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecLinearFusionTest, GenericLinearFusionTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(CostAwareSynthesis::synthesize(circ, prog));
+
+    constexpr std::size_t                nPatterns = 2U * PATTERNS_PER_WORD + 9U;
+    std::mt19937_64                      rng(42U);
+    std::vector<boost::dynamic_bitset<>> inputs(nPatterns, boost::dynamic_bitset<>(circ.getLines()));
+    for (auto& input: inputs) {
+        for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+            input.set(l, (rng() & 1U) != 0U);
+        }
+    }
+
+    std::vector<boost::dynamic_bitset<>> expected;
+    bitParallelSimulation(expected, circ, inputs);
+
+    auto                                 statistics = std::make_shared<Properties>();
+    std::vector<boost::dynamic_bitset<>> outputs;
+    fusedSimulation(outputs, circ, inputs, Properties::ptr(), statistics);
+    EXPECT_EQ(expected, outputs);
+
+    const FusedCircuit fused(circ);
+    EXPECT_EQ(fused.numGates() + fused.numFusedGates(), circ.numGates());
+    EXPECT_EQ(statistics->get<unsigned>("fused_gates"), fused.numFusedGates());
+
+    // without fusion, all gates are simulated one by one
+    auto noFusion = std::make_shared<Properties>();
+    noFusion->set("min_run_length", static_cast<unsigned>(circ.numGates() + 1U));
+    fusedSimulation(outputs, circ, inputs, noFusion);
+    EXPECT_EQ(expected, outputs);
+}
+
+TEST(SyrecLinearFusionTest, AffineLayer) {
+    Circuit circ;
+    circ.setLines(4U);
+    circ.appendCnot(0U, 1U);
+    circ.appendNot(2U);
+    circ.appendFredkin(1U, 2U);
+    circ.appendCnot(2U, 3U);
+    circ.appendCnot(2U, 3U);
+    circ.appendFredkin(1U, 2U);
+    circ.appendToffoli(0U, 1U, 3U);
+    circ.appendNot(0U);
+    circ.appendNot(0U);
+
+    const FusedCircuit fused(circ);
+    EXPECT_EQ(fused.numLayers(), 2U);
+    EXPECT_EQ(fused.numFusedGates(), 8U);
+    EXPECT_EQ(fused.numGates(), 1U);
+
+    std::vector<boost::dynamic_bitset<>> inputs;
+    for (unsigned long v = 0U; v < 16U; ++v) {
+        inputs.emplace_back(4U, v);
+    }
+    std::vector<boost::dynamic_bitset<>> expected;
+    std::vector<boost::dynamic_bitset<>> outputs;
+    bitParallelSimulation(expected, circ, inputs);
+    fusedSimulation(outputs, circ, inputs);
+    EXPECT_EQ(expected, outputs);
+
+    inputs.emplace_back(6U, 0x20U);
+    EXPECT_THROW(fusedSimulation(outputs, circ, inputs), std::invalid_argument);
+}
+
+TEST(SyrecLinearFusionTest, CnotChainIsNotFused) {
+    // every CNOT adds all previous lines to the next one, so the layer would have more entries than the chain has gates
+    Circuit circ;
+    circ.setLines(9U);
+    for (unsigned l = 0U; l < 8U; ++l) {
+        circ.appendCnot(l, l + 1U);
+    }
+
+    const FusedCircuit fused(circ);
+    EXPECT_EQ(fused.numLayers(), 0U);
+    EXPECT_EQ(fused.numFusedGates(), 0U);
+    EXPECT_EQ(fused.numGates(), circ.numGates());
+
+    std::vector<boost::dynamic_bitset<>> inputs;
+    for (unsigned long v = 0U; v < 512U; ++v) {
+        inputs.emplace_back(9U, v);
+    }
+    std::vector<boost::dynamic_bitset<>> expected;
+    std::vector<boost::dynamic_bitset<>> outputs;
+    bitParallelSimulation(expected, circ, inputs);
+    fusedSimulation(outputs, circ, inputs);
+    EXPECT_EQ(expected, outputs);
+}
+
+TEST(SyrecLinearFusionTest, Instances) {
+    auto sub = std::make_shared<Circuit>();
+    sub->setLines(3U);
+    sub->appendCnot(0U, 1U);
+    sub->appendCnot(0U, 1U);
+    sub->appendNot(2U);
+    sub->appendToffoli(0U, 1U, 2U);
+
+    Circuit circ;
+    circ.setLines(4U);
+    circ.appendInstance(sub, {3U, 2U, 1U});
+    circ.appendNot(0U);
+    circ.appendInstance(sub, {0U, 1U, 2U}, true);
+
+    // the mapped gates of the instances are fused without expanding them
+    const FusedCircuit fused(circ);
+    EXPECT_EQ(fused.numGates() + fused.numFusedGates(), circ.numGates());
+    EXPECT_EQ(circ.getInstances().size(), 2U);
+
+    std::vector<boost::dynamic_bitset<>> inputs;
+    for (unsigned long v = 0U; v < 16U; ++v) {
+        inputs.emplace_back(4U, v);
+    }
+    std::vector<boost::dynamic_bitset<>> expected;
+    std::vector<boost::dynamic_bitset<>> outputs;
+    bitParallelSimulation(expected, circ, inputs);
+    fusedSimulation(outputs, circ, inputs);
+    EXPECT_EQ(expected, outputs);
+}
@@ -0,0 +1,158 @@
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/profiling_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <boost/dynamic_bitset.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecProfilingSimulationTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecProfilingSimulationTest, SyrecProfilingSimulationTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "call_8",
+                                 "for_4",
+                                 "modulo_2",
+                                 "negate_8",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecProfilingSimulationTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecProfilingSimulationTest, GenericProfilingSimulationTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+    constexpr std::size_t                nPatterns = 2U * PATTERNS_PER_WORD + 5U;
+    std::mt19937_64                      rng(42U);
+    std::vector<boost::dynamic_bitset<>> inputs(nPatterns, boost::dynamic_bitset<>(circ.getLines()));
+    for (auto& input: inputs) {
+        for (std::size_t l = 0U; l < circ.getLines(); ++l) {
+            input.set(l, (rng() & 1U) != 0U);
+        }
+    }
+
+    SimulationProfile                    profile;
+    std::vector<boost::dynamic_bitset<>> outputs;
+    profilingSimulation(profile, outputs, circ, inputs);
+
+    std::vector<boost::dynamic_bitset<>> expected;
+    bitParallelSimulation(expected, circ, inputs);
+    EXPECT_EQ(expected, outputs);
+
+    EXPECT_EQ(profile.patterns, nPatterns);
+    ASSERT_EQ(profile.gateActivations.size(), circ.numGates());
+    ASSERT_EQ(profile.lineToggles.size(), circ.getLines());
+    EXPECT_TRUE(std::all_of(profile.gateActivations.cbegin(), profile.gateActivations.cend(), [](const auto a) { return a <= nPatterns; }));
+
+    // every synthesized gate carries the source line it has been synthesized from
+    std::uint64_t gates       = 0U;
+    std::uint64_t activations = 0U;
+    for (const auto& [lno, activity]: profile.sourceLines) {
+        gates += activity.gates;
+        activations += activity.activations;
+    }
+    EXPECT_EQ(gates, circ.numGates());
+    EXPECT_EQ(activations, std::accumulate(profile.gateActivations.cbegin(), profile.gateActivations.cend(), std::uint64_t{0U}));
+}
+
+TEST(SyrecProfilingSimulationTest, ActivationsAndToggles) {
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendCnot(0U, 1U);
+    circ.appendFredkin(1U, 2U).controls.emplace(0U);
+    circ.annotate(**circ.begin(), "lno", "4");
+
+    // all eight assignments of the three lines
+    std::vector<boost::dynamic_bitset<>> inputs;
+    for (unsigned long v = 0U; v < 8U; ++v) {
+        inputs.emplace_back(3U, v);
+    }
+
+    SimulationProfile                    profile;
+    std::vector<boost::dynamic_bitset<>> outputs;
+    profilingSimulation(profile, outputs, circ, inputs);
+
+    // both gates are activated by line 0, the Fredkin gate swaps where lines 1 and 2 differ after the CNOT
+    EXPECT_EQ(profile.gateActivations, std::vector<std::uint64_t>({4U, 4U}));
+    EXPECT_EQ(profile.lineToggles, std::vector<std::uint64_t>({0U, 4U + 2U, 2U}));
+
+    ASSERT_EQ(profile.sourceLines.size(), 1U);
+    EXPECT_EQ(profile.sourceLines.at(4U).gates, 1U);
+    EXPECT_EQ(profile.sourceLines.at(4U).activations, 4U);
+    EXPECT_EQ(profile.sourceLines.at(4U).toggles, 4U);
+
+    inputs.emplace_back(4U, 8U);
+    EXPECT_THROW(profilingSimulation(profile, outputs, circ, inputs), std::invalid_argument);
+}
+
+TEST(SyrecProfilingSimulationTest, Instances) {
+    auto sub = std::make_shared<Circuit>();
+    sub->setLines(2U);
+    sub->annotate(sub->appendCnot(0U, 1U), "lno", 4U);
+    sub->appendNot(0U);
+
+    Circuit circ;
+    circ.setLines(3U);
+    circ.annotate(circ.appendNot(2U), "lno", 2U);
+    circ.appendInstance(sub, {0U, 1U});
+    circ.annotate(circ.appendCnot(2U, 0U), "lno", 2U);
+    circ.appendInstance(sub, {2U, 1U}, true);
+
+    Circuit flat;
+    flat.setLines(3U);
+    flat.insertCircuit(0U, circ, {});
+
+    std::vector<boost::dynamic_bitset<>> inputs;
+    for (unsigned long v = 0U; v < 8U; ++v) {
+        inputs.emplace_back(3U, v);
+    }
+
+    // the activity of the gates of the instances is attributed to the source lines of the sub-circuit
+    SimulationProfile                    profile;
+    SimulationProfile                    flatProfile;
+    std::vector<boost::dynamic_bitset<>> outputs;
+    std::vector<boost::dynamic_bitset<>> flatOutputs;
+    profilingSimulation(profile, outputs, circ, inputs);
+    profilingSimulation(flatProfile, flatOutputs, flat, inputs);
+    EXPECT_EQ(outputs, flatOutputs);
+    EXPECT_EQ(profile.gateActivations, flatProfile.gateActivations);
+    ASSERT_EQ(profile.sourceLines.size(), 2U);
+    ASSERT_EQ(flatProfile.sourceLines.size(), 2U);
+    for (const auto lno: {2U, 4U}) {
+        EXPECT_EQ(profile.sourceLines.at(lno).gates, 2U);
+        EXPECT_EQ(profile.sourceLines.at(lno).activations, flatProfile.sourceLines.at(lno).activations);
+        EXPECT_EQ(profile.sourceLines.at(lno).toggles, flatProfile.sourceLines.at(lno).toggles);
+    }
+    EXPECT_EQ(profile.sourceLines.at(2U).activations, 8U + 4U);
+    EXPECT_EQ(circ.getInstances().size(), 2U);
+}
@@ -0,0 +1,142 @@
+#include "algorithms/synthesis/syrec_cost_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/io/real_reader.hpp"
+#include "core/io/real_writer.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecRealReaderTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecRealReaderTest, SyrecRealReaderTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "call_8",
+                                 "divide_2",
+                                 "for_4",
+                                 "modulo_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecRealReaderTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecRealReaderTest, GenericRealReaderTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(CostAwareSynthesis::synthesize(circ, prog));
+
+    const auto realFileName = testing::TempDir() + GetParam() + ".real";
+    ASSERT_TRUE(toRealFile(circ, realFileName));
+
+    Circuit read;
+    ASSERT_TRUE(readReal(read, realFileName));
+    EXPECT_EQ(read.getLines(), circ.getLines());
+    EXPECT_EQ(read.getInputs(), circ.getInputs());
+    EXPECT_EQ(read.getOutputs(), circ.getOutputs());
+    EXPECT_EQ(read.getConstants(), circ.getConstants());
+    EXPECT_EQ(read.getGarbage(), circ.getGarbage());
+    EXPECT_EQ(read.toQasm(), circ.toQasm());
+    EXPECT_EQ(read.quantumCost(), circ.quantumCost());
+    EXPECT_EQ(toReal(read), toReal(circ));
+}
+
+TEST(SyrecRealReaderTest, RevLibFile) {
+    std::istringstream is("# a RevLib benchmark\n"
+                          ".version 1.0\n"
+                          ".numvars 4\n"
+                          ".variables a b c d\n"
+                          ".inputs a b \"carry in\" zero\n"
+                          ".outputs a \"sum\" g1 g2\n"
+                          ".constants ---0\n"
+                          ".garbage --11\n"
+                          ".inputbus x a b\n"
+                          "\n"
+                          ".begin\n"
+                          "\tt1 a\r\n"
+                          "T3 a b d\n"
+                          "# comment within the gates\n"
+                          "f3 d b c\n"
+                          "t2 c a\n"
+                          ".end\n");
+    Circuit circ;
+    parseReal(circ, is);
+
+    EXPECT_EQ(circ.getLines(), 4U);
+    EXPECT_EQ(circ.getInputs(), (std::vector<std::string>{"a", "b", "carry in", "zero"}));
+    EXPECT_EQ(circ.getOutputs(), (std::vector<std::string>{"a", "sum", "g1", "g2"}));
+    EXPECT_EQ(circ.getConstants(), (std::vector<constant>{constant(), constant(), constant(), false}));
+    EXPECT_EQ(circ.getGarbage(), (std::vector<bool>{false, false, true, true}));
+    EXPECT_EQ(circ.toQasm(), "OPENQASM 2.0;\ninclude \"qelib1.inc\";\nqreg q[4];\n"
+                             "x q[0];\n"
+                             "ccx q[0], q[1], q[3];\n"
+                             "cswap q[3], q[1], q[2];\n"
+                             "cx q[2], q[0];\n");
+}
+
+TEST(SyrecRealReaderTest, DefaultNames) {
+    std::istringstream is(".numvars 2\n.variables x y\n.begin\nt2 x y\n.end\n");
+    Circuit            circ;
+    parseReal(circ, is);
+    EXPECT_EQ(circ.getInputs(), (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(circ.getOutputs(), (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(circ.numGates(), 1U);
+}
+
+TEST(SyrecRealReaderTest, InvalidFiles) {
+    const auto parse = [](const std::string& content) {
+        std::istringstream is(content);
+        Circuit            circ;
+        parseReal(circ, is);
+    };
+    const std::string header = ".numvars 3\n.variables a b c\n";
+
+    EXPECT_THROW(parse(header + ".begin\nt2 a b\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + "t2 a b\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".begin\nt3 a b\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".begin\nt2 a x\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".begin\nt2 -a b\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".begin\nt2 a a\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".begin\nf1 a\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".begin\nv2 a b\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".constants 0-\n.begin\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".garbage 0--\n.begin\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(header + ".inputs \"a b\n.begin\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(".numvars 2\n.variables a b c\n.begin\n.end\n"), std::runtime_error);
+    EXPECT_THROW(parse(".numvars 2\n.variables a a\n.begin\n.end\n"), std::runtime_error);
+
+    try {
+        parse(header + ".begin\nt1 a\nt2 a d\n.end\n");
+        FAIL() << "unknown variable not detected";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("line 5"), std::string::npos);
+    }
+
+    Circuit circ;
+    circ.setLines(1U);
+    circ.appendNot(0U);
+    std::istringstream is(header + ".begin\n.end\n");
+    EXPECT_THROW(parseReal(circ, is), std::invalid_argument);
+    EXPECT_FALSE(readReal(circ, "./circuits/missing.real"));
+}
@@ -0,0 +1,145 @@
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/io/real_writer.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace syrec;
+
+class SyrecRealWriterTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecRealWriterTest, SyrecRealWriterTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "binary_numeric",
+                                 "for_4",
+                                 "multiply_2",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecRealWriterTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecRealWriterTest, GenericRealWriterTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+    const auto real = toReal(circ);
+    EXPECT_EQ(real.rfind(".version 2.0\n", 0U), 0U);
+    EXPECT_EQ(static_cast<std::size_t>(std::count(real.begin(), real.end(), '\n')), circ.numGates() + 9U);
+    EXPECT_TRUE(toRealFile(circ, testing::TempDir() + GetParam() + ".real"));
+
+    std::stringstream qasm;
+    circ.toQasm(qasm);
+    EXPECT_EQ(qasm.str(), circ.toQasm());
+}
+
+TEST(SyrecRealWriterTest, EmittedCode) {
+    Circuit circ;
+    circ.setLines(3U);
+    circ.setInputs({"a", "b.0", "c"});
+    circ.setOutputs({"a", "b.0", "garbage"});
+    circ.setConstants({constant(), constant(), false});
+    circ.setGarbage({false, false, true});
+    circ.appendNot(0U);
+    circ.appendToffoli(0U, 1U, 2U);
+    circ.appendFredkin(1U, 2U).controls.emplace(0U);
+
+    EXPECT_EQ(toReal(circ),
+              ".version 2.0\n"
+              ".numvars 3\n"
+              ".variables x0 x1 x2\n"
+              ".inputs a \"b.0\" c\n"
+              ".outputs a \"b.0\" garbage\n"
+              ".constants --0\n"
+              ".garbage --1\n"
+              ".begin\n"
+              "t1 x0\n"
+              "t3 x0 x1 x2\n"
+              "f3 x0 x1 x2\n"
+              ".end\n");
+}
+
+TEST(SyrecRealWriterTest, ParallelFormatting) {
+    Circuit circ;
+    circ.setLines(16U);
+    for (std::size_t i = 0U; i < 100000U; ++i) {
+        if (i % 3U == 0U) {
+            circ.appendFredkin(i % 16U, (i + 5U) % 16U);
+        } else {
+            circ.appendToffoli(i % 16U, (i + 1U) % 16U, (i + 2U) % 16U);
+        }
+    }
+
+    std::stringstream sequentialReal;
+    std::stringstream parallelReal;
+    writeReal(sequentialReal, circ, 1U);
+    writeReal(parallelReal, circ, 4U);
+    EXPECT_EQ(sequentialReal.str(), parallelReal.str());
+
+    std::stringstream parallelQasm;
+    circ.toQasm(parallelQasm, 4U);
+    EXPECT_EQ(parallelQasm.str(), circ.toQasm());
+}
+
+TEST(SyrecRealWriterTest, ParallelFormattingError) {
+    Circuit circ;
+    circ.setLines(3U);
+    for (std::size_t i = 0U; i < 100000U; ++i) {
+        circ.appendToffoli(0U, 1U, 2U);
+    }
+    // a gate without a type in a chunk that is formatted by another thread than the calling one
+    circ.insertGate(90000U).targets.emplace(0U);
+
+    for (const auto nThreads: {1U, 4U}) {
+        std::stringstream real;
+        EXPECT_THROW(writeReal(real, circ, nThreads), std::runtime_error);
+    }
+}
+
+TEST(SyrecRealWriterTest, Instances) {
+    auto sub = std::make_shared<Circuit>();
+    sub->setLines(2U);
+    sub->appendNot(0U);
+    sub->appendFredkin(0U, 1U);
+
+    Circuit circ;
+    circ.setLines(3U);
+    circ.appendCnot(0U, 1U);
+    circ.appendInstance(sub, {2U, 0U});
+    circ.appendInstance(sub, {1U, 2U}, true);
+
+    // the gates of the instances are written like those of a flat copy, independent of the number of threads
+    Circuit flat;
+    flat.setLines(3U);
+    flat.insertCircuit(0U, circ, {});
+    for (const auto nThreads: {1U, 4U}) {
+        std::stringstream real;
+        writeReal(real, circ, nThreads);
+        EXPECT_EQ(real.str(), toReal(flat));
+    }
+    EXPECT_NE(toReal(circ).find("t1 x2\nf2 x0 x2\nf2 x1 x2\nt1 x1\n"), std::string::npos);
+    EXPECT_EQ(circ.getInstances().size(), 2U);
+}
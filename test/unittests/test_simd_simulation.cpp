@@ -0,0 +1,85 @@
+#include "algorithms/simulation/bit_parallel_simulation.hpp"
+#include "algorithms/simulation/compiled_circuit.hpp"
+#include "algorithms/simulation/simd_simulation.hpp"
+#include "algorithms/synthesis/syrec_line_aware_synthesis.hpp"
+#include "core/circuit.hpp"
+#include "core/syrec/program.hpp"
+
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace syrec;
+
+class SyrecSimdSimulationTest: public testing::TestWithParam<std::string> {
+protected:
+    std::string testCircuitsDir = "./circuits/";
+    std::string fileName;
+
+    void SetUp() override {
+        fileName = testCircuitsDir + GetParam() + ".src";
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(SyrecSimdSimulationTest, SyrecSimdSimulationTest,
+                         testing::Values(
+                                 "alu_2",
+                                 "call_8",
+                                 "divide_2",
+                                 "modulo_2",
+                                 "multiply_2",
+                                 "negate_8",
+                                 "swap_2"),
+                         [](const testing::TestParamInfo<SyrecSimdSimulationTest::ParamType>& info) {
+                             auto s = info.param;
+                             std::replace( s.begin(), s.end(), '-', '_');
+                             return s; });
+
+TEST_P(SyrecSimdSimulationTest, GenericSimdSimulationTest) {
+    Circuit             circ;
+    Program             prog;
+    ReadProgramSettings settings;
+    std::string         errorString;
+
+    errorString = prog.read(fileName, settings);
+    EXPECT_TRUE(errorString.empty());
+
+    EXPECT_TRUE(LineAwareSynthesis::synthesize(circ, prog));
+
+    const CompiledCircuit compiled(circ);
+    const std::size_t     nLines = circ.getLines();
+    std::mt19937_64       rng(42U);
+
+    // every level is run, the unsupported ones on the portable kernel
+    for (const auto level: {SimdLevel::AVX2, SimdLevel::AVX512}) {
+        const std::size_t        nWords = simdWordsPerLine(level);
+        std::vector<PatternWord> lines(nLines * nWords);
+        std::generate(lines.begin(), lines.end(), [&rng]() { return rng(); });
+
+        // the w-th word of every line forms an independent 64-pattern block
+        std::vector<std::vector<PatternWord>> expected(nWords, std::vector<PatternWord>(nLines));
+        for (std::size_t w = 0U; w < nWords; ++w) {
+            for (std::size_t l = 0U; l < nLines; ++l) {
+                expected[w][l] = lines[(l * nWords) + w];
+            }
+            bitParallelSimulation(expected[w], compiled);
+        }
+
+        simdSimulation(lines, compiled, level);
+
+        for (std::size_t w = 0U; w < nWords; ++w) {
+            for (std::size_t l = 0U; l < nLines; ++l) {
+                EXPECT_EQ(expected[w][l], lines[(l * nWords) + w]);
+            }
+        }
+    }
+}
+
+TEST(SyrecSimdSimulationTest, WordsPerLine) {
+    EXPECT_EQ(simdWordsPerLine(SimdLevel::Scalar), 1U);
+    EXPECT_EQ(simdWordsPerLine(SimdLevel::AVX2), 4U);
+    EXPECT_EQ(simdWordsPerLine(SimdLevel::AVX512), 8U);
+}
@@ -0,0 +1,68 @@
+#include "core/gate.hpp"
+#include "core/utils/small_set.hpp"
+
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace syrec;
+
+TEST(SmallSetTest, OrderedUniqueValues) {
+    SmallSet<std::size_t, 3U> s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_TRUE(s.emplace(5U).second);
+    EXPECT_TRUE(s.insert(1U).second);
+    EXPECT_FALSE(s.insert(5U).second);
+    EXPECT_TRUE(s.emplace(3U).second);
+    EXPECT_EQ(std::vector<std::size_t>(s.begin(), s.end()), (std::vector<std::size_t>{1U, 3U, 5U}));
+
+    // grows beyond the inline storage
+    s.insert({9U, 0U, 7U});
+    EXPECT_EQ(s.size(), 6U);
+    EXPECT_EQ(std::vector<std::size_t>(s.begin(), s.end()), (std::vector<std::size_t>{0U, 1U, 3U, 5U, 7U, 9U}));
+    EXPECT_EQ(s.count(7U), 1U);
+    EXPECT_EQ(s.count(4U), 0U);
+    EXPECT_EQ(s.erase(3U), 1U);
+    EXPECT_EQ(s.erase(3U), 0U);
+    EXPECT_EQ(*s.find(5U), 5U);
+    EXPECT_EQ(s.find(3U), s.end());
+
+    const auto copy = s;
+    EXPECT_EQ(copy, s);
+    auto moved = std::move(s);
+    EXPECT_EQ(moved, copy);
+    moved = SmallSet<std::size_t, 3U>{2U};
+    EXPECT_EQ(std::vector<std::size_t>(moved.begin(), moved.end()), (std::vector<std::size_t>{2U}));
+    EXPECT_NE(moved, copy);
+}
+
+TEST(SmallSetTest, BehavesLikeStdSet) {
+    std::mt19937_64 rng(7U);
+    for (std::size_t round = 0U; round < 200U; ++round) {
+        std::set<std::size_t> expected;
+        Gate::line_container  lines;
+        const std::size_t     nOps = rng() % 12U;
+        for (std::size_t i = 0U; i < nOps; ++i) {
+            const std::size_t l = rng() % 10U;
+            if (rng() % 4U == 0U) {
+                EXPECT_EQ(lines.erase(l), expected.erase(l));
+            } else {
+                EXPECT_EQ(lines.insert(l).second, expected.insert(l).second);
+            }
+        }
+        EXPECT_EQ(std::vector<std::size_t>(lines.begin(), lines.end()), std::vector<std::size_t>(expected.begin(), expected.end()));
+
+        auto copy = lines;
+        copy.clear();
+        EXPECT_TRUE(copy.empty());
+        EXPECT_EQ(lines.size(), expected.size());
+    }
+}
+
+TEST(SmallSetTest, CompactGate) {
+    // gates with up to three controls do not allocate lines on the heap
+    EXPECT_LE(sizeof(Gate::line_container), 4U * sizeof(Gate::line));
+}